@@ -0,0 +1,695 @@
+// MIT License - CXCollections
+// Copyright(c) 2020 Dante Falcone (dantefalcone@gmail.com)
+
+#ifndef CX_BTREE_H
+#define CX_BTREE_H
+
+#include "Allocator.hpp"
+#include "Relocate.hpp"
+
+#include <stdint.h>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#if !defined(CX_SSE2)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define CX_SSE2 1
+    #else
+        #define CX_SSE2 0
+    #endif
+#endif
+
+#if CX_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace cyber
+{
+    namespace _ {
+        // in-node key search, returns count of keys ordered before key (lower) or not after key (upper)
+        // arithmetic keys use a branchless full scan which vectorizes, small sorted nodes make this faster than bisection
+        template<typename K, typename C, bool scan = std::is_arithmetic<K>::value>
+        struct BTreeSearch
+        {
+            static inline uint32_t lower(const K* keys, uint32_t n, const K& key, const C& comp) noexcept
+            {
+                uint32_t c = 0;
+                for (uint32_t i = 0; i < n; ++i) c += comp(keys[i], key) ? 1u : 0u;
+                return c;
+            }
+
+            static inline uint32_t upper(const K* keys, uint32_t n, const K& key, const C& comp) noexcept
+            {
+                uint32_t c = 0;
+                for (uint32_t i = 0; i < n; ++i) c += comp(key, keys[i]) ? 0u : 1u;
+                return c;
+            }
+        };
+
+        template<typename K, typename C>
+        struct BTreeSearch<K, C, false>
+        {
+            static inline uint32_t lower(const K* keys, uint32_t n, const K& key, const C& comp)
+            {
+                return uint32_t(std::lower_bound(keys, keys + n, key, comp) - keys);
+            }
+
+            static inline uint32_t upper(const K* keys, uint32_t n, const K& key, const C& comp)
+            {
+                return uint32_t(std::upper_bound(keys, keys + n, key, comp) - keys);
+            }
+        };
+
+#if CX_SSE2
+        static constexpr uint8_t bits4_count[16] = { 0,1,1,2,1,2,2,3,1,2,2,3,2,3,3,4 };
+
+        // 4 keys per compare, bias flips unsigned keys into signed order
+        template<uint32_t bias>
+        struct BTreeSearchSSE2_32
+        {
+            static inline uint32_t lower(const int32_t* keys, uint32_t n, int32_t key) noexcept
+            {
+                const __m128i b = _mm_set1_epi32(int32_t(bias));
+                const __m128i k = _mm_xor_si128(_mm_set1_epi32(key), b);
+                uint32_t c = 0, i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), b);
+                    c += bits4_count[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(v, k)))];
+                }
+                for (; i < n; ++i) c += (int32_t(uint32_t(keys[i]) ^ bias) < int32_t(uint32_t(key) ^ bias)) ? 1u : 0u;
+                return c;
+            }
+
+            static inline uint32_t upper(const int32_t* keys, uint32_t n, int32_t key) noexcept
+            {
+                const __m128i b = _mm_set1_epi32(int32_t(bias));
+                const __m128i k = _mm_xor_si128(_mm_set1_epi32(key), b);
+                uint32_t c = 0, i = 0;
+                for (; i + 4 <= n; i += 4)
+                {
+                    __m128i v = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + i)), b);
+                    c += 4u - bits4_count[_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(v, k)))];
+                }
+                for (; i < n; ++i) c += (int32_t(uint32_t(keys[i]) ^ bias) > int32_t(uint32_t(key) ^ bias)) ? 0u : 1u;
+                return c;
+            }
+        };
+
+        template<>
+        struct BTreeSearch<int32_t, std::less<int32_t>, true>
+        {
+            static inline uint32_t lower(const int32_t* keys, uint32_t n, int32_t key, const std::less<int32_t>&) noexcept { return BTreeSearchSSE2_32<0u>::lower(keys, n, key); }
+            static inline uint32_t upper(const int32_t* keys, uint32_t n, int32_t key, const std::less<int32_t>&) noexcept { return BTreeSearchSSE2_32<0u>::upper(keys, n, key); }
+        };
+
+        template<>
+        struct BTreeSearch<uint32_t, std::less<uint32_t>, true>
+        {
+            static inline uint32_t lower(const uint32_t* keys, uint32_t n, uint32_t key, const std::less<uint32_t>&) noexcept { return BTreeSearchSSE2_32<0x80000000u>::lower(reinterpret_cast<const int32_t*>(keys), n, int32_t(key)); }
+            static inline uint32_t upper(const uint32_t* keys, uint32_t n, uint32_t key, const std::less<uint32_t>&) noexcept { return BTreeSearchSSE2_32<0x80000000u>::upper(reinterpret_cast<const int32_t*>(keys), n, int32_t(key)); }
+        };
+
+        template<>
+        struct BTreeSearch<float, std::less<float>, true>
+        {
+            static inline uint32_t lower(const float* keys, uint32_t n, float key, const std::less<float>&) noexcept
+            {
+                const __m128 k = _mm_set1_ps(key);
+                uint32_t c = 0, i = 0;
+                for (; i + 4 <= n; i += 4) c += bits4_count[_mm_movemask_ps(_mm_cmplt_ps(_mm_loadu_ps(keys + i), k))];
+                for (; i < n; ++i) c += keys[i] < key ? 1u : 0u;
+                return c;
+            }
+
+            static inline uint32_t upper(const float* keys, uint32_t n, float key, const std::less<float>&) noexcept
+            {
+                const __m128 k = _mm_set1_ps(key);
+                uint32_t c = 0, i = 0;
+                for (; i + 4 <= n; i += 4) c += bits4_count[_mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(keys + i), k))];
+                for (; i < n; ++i) c += key < keys[i] ? 0u : 1u;
+                return c;
+            }
+        };
+#endif
+
+        struct BTreeEmpty {};
+
+        // uninitialized in-node storage, elements are constructed and relocated individually
+        template<typename T, size_t N>
+        struct BTreeArray
+        {
+            alignas(T) unsigned char bytes[sizeof(T) * N];
+            inline operator T*() const noexcept { return reinterpret_cast<T*>(const_cast<unsigned char*>(bytes)); }
+        };
+    }
+
+    // B+tree ordered map, a cache friendly replacement for std::map
+    // inner nodes hold only keys and children, key/value pairs live in leaves which are linked for range scans
+    // nodes are sized to roughly nodeBytes and are allocated from pools owned by the tree
+    // elements are shifted, split and merged by relocation, iterators are invalidated by insert and erase
+    template<typename Key, typename T, typename Compare = std::less<Key>, size_t nodeBytes = 512>
+    class BTreeMap
+    {
+        static constexpr size_t header_size = 2 * sizeof(void*) + sizeof(uint32_t);
+        static constexpr size_t leaf_fit = (nodeBytes - header_size) / (sizeof(Key) + sizeof(T));
+        static constexpr size_t inner_fit = (nodeBytes - header_size) / (sizeof(Key) + sizeof(void*));
+
+    public:
+        using key_type = Key;
+        using mapped_type = T;
+        using size_type = size_t;
+
+        static constexpr uint32_t leaf_capacity = uint32_t(leaf_fit < 4 ? 4 : leaf_fit);
+        static constexpr uint32_t inner_capacity = uint32_t(inner_fit < 4 ? 4 : inner_fit);
+
+    private:
+        using Search = _::BTreeSearch<Key, Compare>;
+
+        struct Leaf
+        {
+            Leaf* prev = nullptr;
+            Leaf* next = nullptr;
+            uint32_t count = 0;
+            _::BTreeArray<Key, leaf_capacity> keys;
+            _::BTreeArray<T, leaf_capacity> values;
+        };
+
+        // keys[i] is the lowest bound of children[i + 1]
+        struct Inner
+        {
+            uint32_t count = 0;
+            _::BTreeArray<Key, inner_capacity> keys;
+            void* children[inner_capacity + 1];
+        };
+
+        static constexpr uint32_t leaf_min = leaf_capacity / 2;
+        static constexpr uint32_t inner_min = inner_capacity / 2;
+        static constexpr uint32_t max_height = 32;
+
+    public:
+        class iterator
+        {
+            friend class BTreeMap;
+            Leaf* leaf = nullptr;
+            uint32_t i = 0;
+            iterator(Leaf* l, uint32_t idx) noexcept : leaf(l), i(idx) {}
+
+        public:
+            iterator() noexcept = default;
+
+            inline const Key& key() const noexcept { return leaf->keys[i]; }
+            inline T& value() const noexcept { return leaf->values[i]; }
+
+            inline iterator& operator++() noexcept
+            {
+                if (++i == leaf->count) { leaf = leaf->next; i = 0; }
+                return *this;
+            }
+
+            // not valid on begin() or end()
+            inline iterator& operator--() noexcept
+            {
+                if (i == 0) { leaf = leaf->prev; i = leaf->count; }
+                --i;
+                return *this;
+            }
+
+            inline bool operator==(const iterator& rhs) const noexcept { return leaf == rhs.leaf && i == rhs.i; }
+            inline bool operator!=(const iterator& rhs) const noexcept { return !(*this == rhs); }
+        };
+
+        BTreeMap() noexcept = default;
+        BTreeMap(const BTreeMap&) = delete; // pool storage is unique to each tree
+        BTreeMap& operator=(const BTreeMap&) = delete;
+        ~BTreeMap() noexcept
+        {
+            clear();
+            if (leaf_pool.data) leaf_pool.free();
+            if (inner_pool.data) inner_pool.free();
+        }
+
+        inline size_t size() const noexcept { return count; }
+        inline bool empty() const noexcept { return count == 0; }
+
+        inline iterator begin() const noexcept { return count ? iterator(head, 0) : end(); }
+        inline iterator end() const noexcept { return iterator(); }
+        // iterator to the greatest key or end()
+        inline iterator last() const noexcept { return count ? iterator(tail, tail->count - 1) : end(); }
+
+        // first element with key not ordered before key
+        iterator lower_bound(const Key& key) const
+        {
+            if (!root) return end();
+            Leaf* leaf = find_leaf(key);
+            return make_iterator(leaf, Search::lower(leaf->keys, leaf->count, key, comp));
+        }
+
+        // first element with key ordered after key
+        iterator upper_bound(const Key& key) const
+        {
+            if (!root) return end();
+            Leaf* leaf = find_leaf(key);
+            return make_iterator(leaf, Search::upper(leaf->keys, leaf->count, key, comp));
+        }
+
+        iterator find(const Key& key) const
+        {
+            iterator itr = lower_bound(key);
+            return (itr != end() && !comp(key, itr.key())) ? itr : end();
+        }
+
+        inline bool contains(const Key& key) const { return find(key) != end(); }
+
+        // inserts if key not present, returns the element for key and whether it was inserted
+        template<typename... Args>
+        std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+        {
+            if (!root)
+            {
+                head = tail = new_leaf();
+                root = head;
+            }
+
+            // descend recording the path for split propagation
+            Inner* path[max_height];
+            uint32_t path_i[max_height];
+            void* node = root;
+            for (uint32_t h = 0; h < height; ++h)
+            {
+                Inner* inner = static_cast<Inner*>(node);
+                uint32_t ci = Search::upper(inner->keys, inner->count, key, comp);
+                path[h] = inner;
+                path_i[h] = ci;
+                node = inner->children[ci];
+            }
+
+            Leaf* leaf = static_cast<Leaf*>(node);
+            uint32_t pos = Search::lower(leaf->keys, leaf->count, key, comp);
+            if (pos < leaf->count && !comp(key, leaf->keys[pos]))
+                return { iterator(leaf, pos), false };
+
+            ++count;
+            if (leaf->count < leaf_capacity)
+            {
+                leaf_emplace(leaf, pos, key, std::forward<Args>(args)...);
+                return { iterator(leaf, pos), true };
+            }
+
+            // split full leaf, upper half moves to a new right sibling
+            Leaf* right = new_leaf();
+            uint32_t split = leaf_capacity / 2;
+            right->count = leaf_capacity - split;
+            relocate<Key>(right->keys, leaf->keys + split, right->count);
+            relocate<T>(right->values, leaf->values + split, right->count);
+            leaf->count = split;
+
+            right->prev = leaf;
+            right->next = leaf->next;
+            if (leaf->next) leaf->next->prev = right;
+            else tail = right;
+            leaf->next = right;
+
+            iterator ret;
+            if (pos <= split)
+            {
+                leaf_emplace(leaf, pos, key, std::forward<Args>(args)...);
+                ret = iterator(leaf, pos);
+            }
+            else
+            {
+                leaf_emplace(right, pos - split, key, std::forward<Args>(args)...);
+                ret = iterator(right, pos - split);
+            }
+
+            insert_separator(path, path_i, right->keys[0], right);
+            return { ret, true };
+        }
+
+        inline std::pair<iterator, bool> insert(const Key& key, const T& value) { return emplace(key, value); }
+
+        // default constructs value if key not present
+        inline T& operator[](const Key& key) { return emplace(key).first.value(); }
+
+        // returns number of elements removed
+        size_t erase(const Key& key)
+        {
+            if (!root) return 0;
+
+            Inner* path[max_height];
+            uint32_t path_i[max_height];
+            void* node = root;
+            for (uint32_t h = 0; h < height; ++h)
+            {
+                Inner* inner = static_cast<Inner*>(node);
+                uint32_t ci = Search::upper(inner->keys, inner->count, key, comp);
+                path[h] = inner;
+                path_i[h] = ci;
+                node = inner->children[ci];
+            }
+
+            Leaf* leaf = static_cast<Leaf*>(node);
+            uint32_t pos = Search::lower(leaf->keys, leaf->count, key, comp);
+            if (pos == leaf->count || comp(key, leaf->keys[pos]))
+                return 0;
+
+            leaf_remove(leaf, pos);
+            --count;
+
+            if (height == 0)
+            {
+                if (count == 0)
+                    clear();
+                return 1;
+            }
+
+            if (leaf->count < leaf_min)
+                rebalance_leaf(leaf, path[height - 1], path_i[height - 1]);
+
+            // inner underflow propagates towards the root
+            for (uint32_t h = height - 1; h > 0; --h)
+            {
+                if (path[h]->count >= inner_min) break;
+                rebalance_inner(path[h], path[h - 1], path_i[h - 1]);
+            }
+
+            // shrink root
+            if (height > 0 && static_cast<Inner*>(root)->count == 0)
+            {
+                Inner* old_root = static_cast<Inner*>(root);
+                root = old_root->children[0];
+                --height;
+                delete_inner(old_root);
+            }
+
+            return 1;
+        }
+
+        // returns iterator following the erased element
+        iterator erase(iterator itr)
+        {
+            Key key = itr.key();
+            erase(key);
+            return upper_bound(key);
+        }
+
+        // calls fn(key, value) for keys in [lo, hi), walking linked leaves
+        template<typename Fn>
+        void for_each_range(const Key& lo, const Key& hi, Fn&& fn) const
+        {
+            if (!root) return;
+            Leaf* leaf = find_leaf(lo);
+            uint32_t i = Search::lower(leaf->keys, leaf->count, lo, comp);
+            for (; leaf; leaf = leaf->next, i = 0)
+            {
+                for (; i < leaf->count; ++i)
+                {
+                    if (!comp(leaf->keys[i], hi)) return;
+                    fn(leaf->keys[i], leaf->values[i]);
+                }
+            }
+        }
+
+        void clear() noexcept
+        {
+            if (root) free_node(root, height);
+            root = nullptr;
+            head = tail = nullptr;
+            height = 0;
+            count = 0;
+        }
+
+    private:
+        inline iterator make_iterator(Leaf* leaf, uint32_t i) const noexcept
+        {
+            if (i < leaf->count) return iterator(leaf, i);
+            return leaf->next ? iterator(leaf->next, 0) : end();
+        }
+
+        Leaf* find_leaf(const Key& key) const
+        {
+            void* node = root;
+            for (uint32_t h = 0; h < height; ++h)
+            {
+                const Inner* inner = static_cast<const Inner*>(node);
+                node = inner->children[Search::upper(inner->keys, inner->count, key, comp)];
+            }
+            return static_cast<Leaf*>(node);
+        }
+
+        template<typename... Args>
+        inline void leaf_emplace(Leaf* leaf, uint32_t pos, const Key& key, Args&&... args)
+        {
+            leaf_open(leaf, pos);
+            new(leaf->keys + pos) Key(key);
+            new(leaf->values + pos) T(std::forward<Args>(args)...);
+        }
+
+        // shifts elements at pos up by one leaving pos uninitialized
+        inline void leaf_open(Leaf* leaf, uint32_t pos) noexcept
+        {
+            relocate<Key>(leaf->keys + pos + 1, leaf->keys + pos, leaf->count - pos);
+            relocate<T>(leaf->values + pos + 1, leaf->values + pos, leaf->count - pos);
+            ++leaf->count;
+        }
+
+        inline void leaf_remove(Leaf* leaf, uint32_t pos) noexcept
+        {
+            destroy<Key>(leaf->keys + pos, 1);
+            destroy<T>(leaf->values + pos, 1);
+            relocate<Key>(leaf->keys + pos, leaf->keys + pos + 1, leaf->count - pos - 1);
+            relocate<T>(leaf->values + pos, leaf->values + pos + 1, leaf->count - pos - 1);
+            --leaf->count;
+        }
+
+        // insert separator and right child into parents after a split, splitting parents as needed
+        void insert_separator(Inner** path, uint32_t* path_i, Key sep, void* right)
+        {
+            for (uint32_t h = height; h > 0; --h)
+            {
+                Inner* inner = path[h - 1];
+                uint32_t ci = path_i[h - 1];
+
+                if (inner->count < inner_capacity)
+                {
+                    relocate<Key>(inner->keys + ci + 1, inner->keys + ci, inner->count - ci);
+                    relocate<void*>(inner->children + ci + 2, inner->children + ci + 1, inner->count - ci);
+                    new(inner->keys + ci) Key(std::move(sep));
+                    inner->children[ci + 1] = right;
+                    ++inner->count;
+                    return;
+                }
+
+                // full, gather into scratch then split around the middle key
+                _::BTreeArray<Key, inner_capacity + 1> keys;
+                void* children[inner_capacity + 2];
+                relocate<Key>(keys, inner->keys, ci);
+                new(keys + ci) Key(std::move(sep));
+                relocate<Key>(keys + ci + 1, inner->keys + ci, inner_capacity - ci);
+                std::copy(inner->children, inner->children + ci + 1, children);
+                children[ci + 1] = right;
+                std::copy(inner->children + ci + 1, inner->children + inner_capacity + 1, children + ci + 2);
+
+                uint32_t mid = (inner_capacity + 1) / 2;
+                Inner* sibling = new_inner();
+                inner->count = mid;
+                relocate<Key>(inner->keys, keys, mid);
+                std::copy(children, children + mid + 1, inner->children);
+                sibling->count = inner_capacity - mid;
+                relocate<Key>(sibling->keys, keys + mid + 1, sibling->count);
+                std::copy(children + mid + 1, children + inner_capacity + 2, sibling->children);
+
+                sep = std::move(keys[mid]);
+                destroy<Key>(keys + mid, 1);
+                right = sibling;
+            }
+
+            // root split
+            Inner* new_root = new_inner();
+            new_root->count = 1;
+            new(new_root->keys) Key(std::move(sep));
+            new_root->children[0] = root;
+            new_root->children[1] = right;
+            root = new_root;
+            ++height;
+        }
+
+        void rebalance_leaf(Leaf* leaf, Inner* parent, uint32_t ci)
+        {
+            Leaf* left = ci > 0 ? static_cast<Leaf*>(parent->children[ci - 1]) : nullptr;
+            Leaf* right = ci < parent->count ? static_cast<Leaf*>(parent->children[ci + 1]) : nullptr;
+
+            if (left && left->count > leaf_min)
+            {
+                // borrow greatest from left
+                leaf_open(leaf, 0);
+                --left->count;
+                relocate<Key>(leaf->keys, left->keys + left->count, 1);
+                relocate<T>(leaf->values, left->values + left->count, 1);
+                parent->keys[ci - 1] = leaf->keys[0];
+            }
+            else if (right && right->count > leaf_min)
+            {
+                // borrow least from right
+                relocate<Key>(leaf->keys + leaf->count, right->keys, 1);
+                relocate<T>(leaf->values + leaf->count, right->values, 1);
+                ++leaf->count;
+                --right->count;
+                relocate<Key>(right->keys, right->keys + 1, right->count);
+                relocate<T>(right->values, right->values + 1, right->count);
+                parent->keys[ci] = right->keys[0];
+            }
+            else if (left)
+            {
+                merge_leaves(left, leaf);
+                remove_child(parent, ci - 1);
+            }
+            else
+            {
+                merge_leaves(leaf, right);
+                remove_child(parent, ci);
+            }
+        }
+
+        // moves all of right into left and frees right
+        void merge_leaves(Leaf* left, Leaf* right)
+        {
+            relocate<Key>(left->keys + left->count, right->keys, right->count);
+            relocate<T>(left->values + left->count, right->values, right->count);
+            left->count += right->count;
+            right->count = 0;
+            left->next = right->next;
+            if (right->next) right->next->prev = left;
+            else tail = left;
+            delete_leaf(right);
+        }
+
+        void rebalance_inner(Inner* node, Inner* parent, uint32_t ci)
+        {
+            Inner* left = ci > 0 ? static_cast<Inner*>(parent->children[ci - 1]) : nullptr;
+            Inner* right = ci < parent->count ? static_cast<Inner*>(parent->children[ci + 1]) : nullptr;
+
+            if (left && left->count > inner_min)
+            {
+                // rotate right through parent
+                relocate<Key>(node->keys + 1, node->keys, node->count);
+                relocate<void*>(node->children + 1, node->children, node->count + 1);
+                new(node->keys) Key(std::move(parent->keys[ci - 1]));
+                node->children[0] = left->children[left->count];
+                --left->count;
+                parent->keys[ci - 1] = std::move(left->keys[left->count]);
+                destroy<Key>(left->keys + left->count, 1);
+                ++node->count;
+            }
+            else if (right && right->count > inner_min)
+            {
+                // rotate left through parent
+                new(node->keys + node->count) Key(std::move(parent->keys[ci]));
+                node->children[node->count + 1] = right->children[0];
+                ++node->count;
+                parent->keys[ci] = std::move(right->keys[0]);
+                destroy<Key>(right->keys, 1);
+                --right->count;
+                relocate<Key>(right->keys, right->keys + 1, right->count);
+                relocate<void*>(right->children, right->children + 1, right->count + 1);
+            }
+            else if (left)
+            {
+                merge_inners(left, node, parent, ci - 1);
+            }
+            else
+            {
+                merge_inners(node, right, parent, ci);
+            }
+        }
+
+        // pulls separator ki down from parent, moves all of right into left and frees right
+        void merge_inners(Inner* left, Inner* right, Inner* parent, uint32_t ki)
+        {
+            new(left->keys + left->count) Key(std::move(parent->keys[ki]));
+            relocate<Key>(left->keys + left->count + 1, right->keys, right->count);
+            std::copy(right->children, right->children + right->count + 1, left->children + left->count + 1);
+            left->count += right->count + 1;
+            right->count = 0;
+            delete_inner(right);
+            remove_child(parent, ki);
+        }
+
+        // removes keys[ki] and children[ki + 1]
+        inline void remove_child(Inner* parent, uint32_t ki) noexcept
+        {
+            destroy<Key>(parent->keys + ki, 1);
+            relocate<Key>(parent->keys + ki, parent->keys + ki + 1, parent->count - ki - 1);
+            relocate<void*>(parent->children + ki + 1, parent->children + ki + 2, parent->count - ki - 1);
+            --parent->count;
+        }
+
+        void free_node(void* node, uint32_t h) noexcept
+        {
+            if (h == 0)
+            {
+                delete_leaf(static_cast<Leaf*>(node));
+                return;
+            }
+
+            Inner* inner = static_cast<Inner*>(node);
+            for (uint32_t i = 0; i <= inner->count; ++i)
+                free_node(inner->children[i], h - 1);
+            delete_inner(inner);
+        }
+
+        inline Leaf* new_leaf() { return new(leaf_pool.allocate(1)) Leaf(); }
+        inline Inner* new_inner() { return new(inner_pool.allocate(1)) Inner(); }
+        inline void delete_leaf(Leaf* p) noexcept { destroy<Key>(p->keys, p->count); destroy<T>(p->values, p->count); leaf_pool.deallocate(p, 1); }
+        inline void delete_inner(Inner* p) noexcept { destroy<Key>(p->keys, p->count); inner_pool.deallocate(p, 1); }
+
+        void* root = nullptr;
+        Leaf* head = nullptr;
+        Leaf* tail = nullptr;
+        uint32_t height = 0; // inner levels above the leaves
+        size_t count = 0;
+        Compare comp;
+
+        UniquePoolAllocator<Leaf> leaf_pool;
+        UniquePoolAllocator<Inner> inner_pool;
+    };
+
+    // B+tree ordered set, see BTreeMap
+    template<typename Key, typename Compare = std::less<Key>, size_t nodeBytes = 512>
+    class BTreeSet
+    {
+        using Map = BTreeMap<Key, _::BTreeEmpty, Compare, nodeBytes>;
+
+    public:
+        using key_type = Key;
+        using iterator = typename Map::iterator;
+
+        inline size_t size() const noexcept { return map.size(); }
+        inline bool empty() const noexcept { return map.empty(); }
+        inline iterator begin() const noexcept { return map.begin(); }
+        inline iterator end() const noexcept { return map.end(); }
+        inline iterator last() const noexcept { return map.last(); }
+        inline iterator lower_bound(const Key& key) const { return map.lower_bound(key); }
+        inline iterator upper_bound(const Key& key) const { return map.upper_bound(key); }
+        inline iterator find(const Key& key) const { return map.find(key); }
+        inline bool contains(const Key& key) const { return map.contains(key); }
+        inline std::pair<iterator, bool> insert(const Key& key) { return map.emplace(key); }
+        inline size_t erase(const Key& key) { return map.erase(key); }
+        inline iterator erase(iterator itr) { return map.erase(itr); }
+        inline void clear() noexcept { map.clear(); }
+
+        // calls fn(key) for keys in [lo, hi)
+        template<typename Fn>
+        void for_each_range(const Key& lo, const Key& hi, Fn&& fn) const
+        {
+            map.for_each_range(lo, hi, [&](const Key& key, const _::BTreeEmpty&) { fn(key); });
+        }
+
+    private:
+        Map map;
+    };
+}
+
+#endif // !CX_BTREE_H
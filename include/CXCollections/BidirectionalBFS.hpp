@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "CSRGraph.hpp"
+#include "EpochArray.hpp"
+
+namespace cyber
+{
+
+class ConnectivityIndex;
+
+// point-to-point breadth first search growing from both ends
+// each step expands one full level of whichever side has the smaller frontier, start side over graph and end
+// side over its transpose, and the search stops after the level where the two visited sets first meet
+// explores about 2 * b^(d/2) nodes instead of b^d, visited state is epoch stamped so queries reset in O(1)
+// for BFSNode graphs build a CSRGraph with BuildFromNodes and its transpose once and query those
+class BidirectionalBFS
+{
+public:
+    // returns shortest path as node ids from end to start or nullptr if no path found
+    // reverse is the transpose of graph (pass graph itself for undirected graphs)
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t start, uint32_t end);
+
+    // optional, queries the index rejects return nullptr without searching, nullptr disables
+    inline void SetConnectivityIndex(const ConnectivityIndex* index) { connectivity = index; }
+
+    // nodes visited from either side by the last query
+    inline uint32_t ExploredNodes() const { return explored_nodes; }
+
+private:
+    struct Visit
+    {
+        uint32_t prev; // parent towards this side's root
+        uint32_t depth;
+    };
+
+    struct Side
+    {
+        EpochArray<Visit> visits;
+        std::vector<uint32_t> frontier;
+        std::vector<uint32_t> next_frontier;
+        uint32_t depth = 0; // depth of frontier
+    };
+
+    // expands one level of side, sets meet to the node on the shortest path through the other side found in it
+    void ExpandLevel(const CSRGraphView& adjacency, Side& side, const Side& other, uint32_t& meet);
+
+    Side forward;
+    Side backward;
+    std::vector<uint32_t> path;
+    uint32_t explored_nodes = 0;
+    const ConnectivityIndex* connectivity = nullptr;
+};
+
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+namespace cyber
+{
+
+// index of lowest set bit, v must not be 0
+inline uint32_t CountTrailingZeros64(uint64_t v)
+{
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanForward64(&i, v);
+    return uint32_t(i);
+#else
+    return uint32_t(__builtin_ctzll(v));
+#endif
+}
+
+// bits needed to represent v, 0 for 0
+inline uint32_t BitWidth32(uint32_t v)
+{
+    if (v == 0)
+        return 0;
+#if defined(_MSC_VER)
+    unsigned long i;
+    _BitScanReverse(&i, v);
+    return uint32_t(i) + 1;
+#else
+    return 32 - uint32_t(__builtin_clz(v));
+#endif
+}
+
+inline uint32_t PopCount64(uint64_t v)
+{
+#if defined(_MSC_VER)
+    return uint32_t(__popcnt64(v));
+#else
+    return uint32_t(__builtin_popcountll(v));
+#endif
+}
+
+inline uint64_t ReverseBits64(uint64_t v)
+{
+    v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+    v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((v & 0x0F0F0F0F0F0F0F0Full) << 4);
+    v = ((v >> 8) & 0x00FF00FF00FF00FFull) | ((v & 0x00FF00FF00FF00FFull) << 8);
+    v = ((v >> 16) & 0x0000FFFF0000FFFFull) | ((v & 0x0000FFFF0000FFFFull) << 16);
+    return (v >> 32) | (v << 32);
+}
+
+// flat bitmaps of 64-bit words indexed by node id
+inline bool TestBit(const uint64_t* bits, uint32_t i) { return (bits[i >> 6] >> (i & 63)) & 1; }
+inline void SetBit(uint64_t* bits, uint32_t i) { bits[i >> 6] |= uint64_t(1) << (i & 63); }
+inline size_t BitWords(size_t bitCount) { return (bitCount + 63) / 64; }
+
+}
@@ -2,31 +2,85 @@
 
 #include <stdint.h>
 #include <vector>
-#include <deque>
-#include <unordered_map>
+
+#include "CSRGraph.hpp"
+#include "EpochArray.hpp"
 
 namespace cyber 
 {
 
+class ConnectivityIndex;
+class DynamicGraph;
+
 struct BFSNode
 {
     std::vector<BFSNode*> neighbors;
+    std::vector<uint32_t> costs; // optional edge costs parallel to neighbors for weighted searches, empty means all 1
+    uint32_t id = invalid_node_id; // must be assigned, unique per graph and dense from 0, indexes search state arrays
 };
 
 // each instance of search object holds heap memory for path and search temp values
 // expected usage is to re-use the same class object so that allocated memory is reused
+// visited state is epoch stamped, so a query resets it in O(1) and reaches zero allocations once warmed up
 class BreadthFirstSearch
 {
 public:
     // returns path as vector of node pointers or nullptr if no path found
     // path is only valid until called again
     // if need to call this function multiple times before using path, then copy vector data out
+    // every node reachable from pStart needs its id numbered densely from 0
     const std::vector<BFSNode*>* FindPathReversed(BFSNode* pStart, BFSNode* pEnd);
 
+    // CSR graph search by node id, returns path as node ids from end to start or nullptr if no path found
+    // same validity rules as the node pointer version
+    const std::vector<uint32_t>* FindPathReversed(const CSRGraphView& graph, uint32_t start, uint32_t end);
+
+    // same over a graph with pending edits, the connectivity index is not consulted since edits may outdate it
+    const std::vector<uint32_t>* FindPathReversed(const DynamicGraph& graph, uint32_t start, uint32_t end);
+
+    // forward path output, writes the path from start to end into the caller's buffer without an internal copy
+    // returns the node count of the path, 0 if no path found
+    // if that exceeds capacity nothing is written, WriteLastPath then fills a large enough buffer without searching again
+    // for arenas pass the free tail and advance by the returned count when it fit
+    uint32_t FindPath(BFSNode* pStart, BFSNode* pEnd, BFSNode** out, uint32_t capacity);
+    uint32_t FindPath(BFSNode* pStart, BFSNode* pEnd, uint32_t* outIds, uint32_t capacity); // BFSNode::id path, half the size
+    uint32_t FindPath(const CSRGraphView& graph, uint32_t start, uint32_t end, uint32_t* out, uint32_t capacity);
+    uint32_t FindPath(const DynamicGraph& graph, uint32_t start, uint32_t end, uint32_t* out, uint32_t capacity);
+
+    // writes the path of the last search again, same return as FindPath
+    // node pointers are only available after a BFSNode search, ids after either kind
+    // valid until the next search
+    uint32_t WriteLastPath(BFSNode** out, uint32_t capacity) const;
+    uint32_t WriteLastPath(uint32_t* outIds, uint32_t capacity) const;
+
+    // optional, queries the index rejects return nullptr without searching, nullptr disables
+    inline void SetConnectivityIndex(const ConnectivityIndex* index) { connectivity = index; }
+
 private:
+    // run the search and leave prev links from end back to start, record the path length for WriteLastPath
+    bool SearchNodes(BFSNode* pStart, BFSNode* pEnd);
+    template<typename Graph>
+    bool SearchIds(const Graph& graph, uint32_t nodeCount, uint32_t start, uint32_t end);
+
+    template<typename Graph>
+    const std::vector<uint32_t>* FindIdPathReversed(const Graph& graph, uint32_t nodeCount, uint32_t start, uint32_t end);
+
+    // frontiers are flat queues since each node is enqueued at most once per query
     std::vector<BFSNode*> path;
-    std::deque<BFSNode*> frontier;
-    std::unordered_map<BFSNode*, BFSNode*> node_to_prev_node;
+    std::vector<BFSNode*> frontier;
+    EpochArray<BFSNode*> node_to_prev_node; // indexed by BFSNode::id
+
+    std::vector<uint32_t> id_path;
+    std::vector<uint32_t> id_frontier;
+    EpochArray<uint32_t> id_to_prev_id;
+
+    // last search, end of its prev chain and node count of its path (0 if none)
+    BFSNode* last_end_node = nullptr;
+    uint32_t last_end = invalid_node_id;
+    uint32_t last_length = 0;
+    bool last_nodes = false;
+
+    const ConnectivityIndex* connectivity = nullptr;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace cyber
+{
+
+struct BFSNode;
+struct NodePermutation;
+
+constexpr uint32_t invalid_node_id = 0xFFFFFFFF;
+
+struct CSREdge
+{
+    uint32_t source;
+    uint32_t target;
+};
+
+struct CSRWeightedEdge
+{
+    uint32_t source;
+    uint32_t target;
+    uint32_t weight;
+};
+
+// non-owning compressed sparse row graph, out edges of node n are targets[offsets[n] .. offsets[n + 1])
+// all search algorithms take a view so graphs can live in owned vectors or externally managed memory
+struct CSRGraphView
+{
+    const uint32_t* offsets = nullptr; // node_count + 1 entries
+    const uint32_t* targets = nullptr; // edge_count entries
+    const uint32_t* weights = nullptr; // edge_count entries parallel to targets, nullptr when every edge costs 1
+    uint32_t node_count = 0;
+    uint32_t edge_count = 0;
+
+    inline uint32_t Degree(uint32_t node) const { return offsets[node + 1] - offsets[node]; }
+    inline const uint32_t* NeighborsBegin(uint32_t node) const { return targets + offsets[node]; }
+    inline const uint32_t* NeighborsEnd(uint32_t node) const { return targets + offsets[node + 1]; }
+
+    // edge is an index into targets, e.g. itr - targets while walking neighbors
+    inline uint32_t Weight(uint32_t edge) const { return weights ? weights[edge] : 1; }
+};
+
+// owning compressed sparse row graph with 32-bit node ids
+// two flat arrays replace per-node neighbor vectors so expansion is a linear read instead of a pointer chase
+struct CSRGraph
+{
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint32_t> weights; // empty for unweighted graphs
+
+    inline uint32_t NodeCount() const { return offsets.empty() ? 0 : uint32_t(offsets.size() - 1); }
+    inline uint32_t EdgeCount() const { return uint32_t(targets.size()); }
+
+    inline CSRGraphView View() const
+    {
+        CSRGraphView view;
+        view.offsets = offsets.data();
+        view.targets = targets.data();
+        view.weights = weights.empty() ? nullptr : weights.data();
+        view.node_count = NodeCount();
+        view.edge_count = EdgeCount();
+        return view;
+    }
+
+    inline operator CSRGraphView() const { return View(); }
+
+    // builds from an edge list, out edges keep their input order
+    // undirected adds each edge in both directions
+    void BuildFromEdges(uint32_t nodeCount, const CSREdge* edges, size_t edgeCount, bool undirected = false);
+    void BuildFromEdges(uint32_t nodeCount, const CSRWeightedEdge* edges, size_t edgeCount, bool undirected = false);
+
+    // builds the reverse graph (in edges become out edges), bottom-up and backward searches scan it
+    // for undirected graphs the graph is its own transpose, weights follow their edges
+    void BuildTranspose(const CSRGraphView& graph);
+
+    // builds graph relabeled by perm (see GraphReordering.hpp), out edges sorted by new target id, weights follow
+    void BuildPermuted(const CSRGraphView& graph, const NodePermutation& perm);
+
+    // builds from a BFSNode graph, node ids are positions in the nodes array
+    // neighbors not in the array are dropped, the graph is weighted if any node has costs
+    void BuildFromNodes(BFSNode* const* nodes, size_t nodeCount);
+};
+
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+// on-disk CSR graph, little endian, every section starts on a 64 byte boundary:
+//   CSRFileHeader | offsets (node_count + 1 x uint32) | targets (edge_count x uint32) | weights (optional, same)
+// checksum is FNV-1a over the 64-bit words after the header, so a truncated or damaged file can be detected
+struct CSRFileHeader
+{
+    static constexpr uint32_t magic_value = 0x31475843; // "CXG1"
+    static constexpr uint32_t current_version = 1;
+    static constexpr uint32_t flag_weighted = 1;
+
+    uint32_t magic;
+    uint32_t version;
+    uint32_t node_count;
+    uint32_t edge_count;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t offsets_offset; // byte offsets of the sections from the start of the file
+    uint64_t targets_offset;
+    uint64_t weights_offset; // 0 when unweighted
+    uint64_t file_bytes;
+    uint64_t checksum;
+};
+
+// read-only memory mapping of a graph file, View() points straight into the mapping so opening costs no
+// parsing or copying and pages load on first touch, the view is valid until Close or destruction
+class CSRGraphFile
+{
+public:
+    CSRGraphFile() = default;
+    ~CSRGraphFile() { Close(); }
+    CSRGraphFile(const CSRGraphFile&) = delete;
+    CSRGraphFile& operator=(const CSRGraphFile&) = delete;
+
+    // returns false if the file is missing, not a graph file or inconsistent
+    // the structure check covers the header, section bounds and first / last offsets, only the checksum guards
+    // interior offsets and target ids, so a damaged file opened unverified can make searches index out of bounds
+    // verifyChecksum reads every page, leave off only for instant opens of trusted files
+    bool Open(const char* path, bool verifyChecksum = false);
+    void Close();
+
+    inline bool IsOpen() const { return data != nullptr; }
+    inline const CSRGraphView& View() const { return view; }
+    inline operator CSRGraphView() const { return view; }
+
+    static bool Write(const char* path, const CSRGraphView& graph);
+
+    // converts a text edge list, one "source target [weight]" per line, '#' or '%' lines are comments
+    // node count is the largest id + 1, the graph is weighted if any line has a weight (others default to 1)
+    // fails on malformed lines, negative values and ids or weights of 0xFFFFFFFF or more
+    static bool ConvertEdgeList(const char* edgeListPath, const char* outPath, bool undirected = false);
+
+    // FNV-1a over 64-bit words
+    static uint64_t Checksum(const void* words, size_t byteCount);
+
+private:
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+    CSRGraphView view;
+
+#if defined(_WIN32)
+    void* file_handle = nullptr;
+    void* mapping_handle = nullptr;
+#endif
+};
+
+}
@@ -0,0 +1,81 @@
+// MIT License - CXCollections
+// Copyright(c) 2020 Dante Falcone (dantefalcone@gmail.com)
+
+#ifndef CX_COMPRESSED_INT_SEQUENCE_H
+#define CX_COMPRESSED_INT_SEQUENCE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace cyber
+{
+    // append-only sequence of 32-bit unsigned integers bit packed in blocks of 128
+    // sorted sequences store deltas between neighbors, unsorted sequences store offsets from the block minimum (frame of reference)
+    // each block is packed at the bit width of its largest delta/offset in 4 interleaved 32-bit lanes so a block
+    // decodes with 4-wide SIMD shifts and masks, a skip entry per block (first value, bit width, data offset) gives random access
+    // the last partial block is kept unpacked until it fills
+    class CompressedIntSequence
+    {
+    public:
+        static constexpr uint32_t block_size = 128;
+
+        explicit CompressedIntSequence(bool sorted = true) noexcept : is_sorted(sorted) {}
+
+        // sorted sequences require values in non-decreasing order
+        void push_back(uint32_t value);
+        void assign(const uint32_t* values, size_t count);
+        void clear() noexcept;
+
+        inline size_t size() const noexcept { return count; }
+        inline bool empty() const noexcept { return count == 0; }
+        inline bool sorted() const noexcept { return is_sorted; }
+        inline size_t block_count() const noexcept { return (count + block_size - 1) / block_size; }
+
+        // O(1) for unsorted, O(index within block) for sorted
+        uint32_t operator[](size_t i) const noexcept;
+
+        // decodes block b into out, returns number of values written (block_size except for the last block)
+        uint32_t decode_block(size_t b, uint32_t* out) const noexcept;
+
+        // decodes the full sequence into out which must hold size() values
+        void decode(uint32_t* out) const noexcept;
+
+        // sorted only - index of the first value not less than value, size() if none
+        size_t lower_bound(uint32_t value) const noexcept;
+
+        // calls fn(uint32_t) for every value in order, decoding a block at a time
+        template<typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            uint32_t buffer[block_size];
+            for (size_t b = 0, n = block_count(); b < n; ++b)
+            {
+                uint32_t decoded = decode_block(b, buffer);
+                for (uint32_t i = 0; i < decoded; ++i)
+                    fn(buffer[i]);
+            }
+        }
+
+        // heap bytes used by packed data and skip index
+        inline size_t memory_bytes() const noexcept { return packed.capacity() * sizeof(uint32_t) + skip.capacity() * sizeof(BlockHeader); }
+
+    private:
+        struct BlockHeader
+        {
+            uint32_t base;   // first value (sorted) or minimum (unsorted)
+            uint32_t offset; // word offset into packed
+            uint32_t bits;
+        };
+
+        void flush_tail();
+
+        std::vector<uint32_t> packed;
+        std::vector<BlockHeader> skip;
+        uint32_t tail[block_size];
+        size_t count = 0;
+        bool is_sorted;
+    };
+}
+
+#endif // !CX_COMPRESSED_INT_SEQUENCE_H
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "CSRGraph.hpp"
+#include "EpochArray.hpp"
+
+namespace cyber
+{
+
+// reachability filter answering "no path" in O(1) so searches can skip exploring a whole component
+// undirected graphs keep connected components in a union-find, the answer is exact
+// directed graphs also keep strong components (Tarjan) in a topological order of the condensation, a pair is
+// rejected if its weak components differ or the target's strong component comes first in that order, so
+// mutually reachable pairs are always accepted and pairs in different strong components may be accepted
+// without being reachable
+// edges can be inserted after Build, the order is repaired with Pearce-Kelly and strong components merge when an
+// insertion closes a cycle, removal needs a new Build
+// point searches take an index through SetConnectivityIndex, it must cover the graph they are given
+class ConnectivityIndex
+{
+public:
+    void Build(const CSRGraphView& graph, bool undirected);
+
+    // records a source -> target edge (both directions when built undirected)
+    void AddEdge(uint32_t source, uint32_t target);
+
+    // false only if no path from source to target exists
+    inline bool MayReach(uint32_t source, uint32_t target) const
+    {
+        if (FindRoot(weak_parent, source) != FindRoot(weak_parent, target))
+            return false;
+        if (undirected)
+            return true;
+
+        uint32_t a = FindRoot(scc_parent, source), b = FindRoot(scc_parent, target);
+        return a == b || order[a] < order[b];
+    }
+
+    // connected (undirected) or strongly connected (directed)
+    inline bool SameComponent(uint32_t a, uint32_t b) const
+    {
+        const std::vector<uint32_t>& parent = undirected ? weak_parent : scc_parent;
+        return FindRoot(parent, a) == FindRoot(parent, b);
+    }
+
+    // representative node of the connected or strongly connected component of node
+    inline uint32_t ComponentOf(uint32_t node) const { return FindRoot(undirected ? weak_parent : scc_parent, node); }
+
+    inline uint32_t ComponentCount() const { return component_count; }
+    inline bool IsUndirected() const { return undirected; }
+
+private:
+    // union by size keeps trees shallow, Build flattens them so queries take one step until edges are added
+    static inline uint32_t FindRoot(const std::vector<uint32_t>& parent, uint32_t node)
+    {
+        while (parent[node] != node)
+            node = parent[node];
+        return node;
+    }
+
+    static uint32_t Find(std::vector<uint32_t>& parent, uint32_t node);
+    bool UnionWeak(uint32_t a, uint32_t b);
+    void BuildStrong(const CSRGraphView& graph);
+    void Reorder(uint32_t x, uint32_t y);
+    void MergeStrong(const std::vector<uint32_t>& members);
+
+    bool undirected = true;
+    uint32_t component_count = 0;
+
+    std::vector<uint32_t> weak_parent;
+    std::vector<uint32_t> weak_size;
+
+    // directed only, order, size and condensation edges are kept at representatives
+    // edge lists hold representatives at insertion time and are resolved through scc_parent when walked
+    std::vector<uint32_t> scc_parent;
+    std::vector<uint32_t> scc_size;
+    std::vector<uint32_t> order;
+    std::vector<std::vector<uint32_t>> scc_out;
+    std::vector<std::vector<uint32_t>> scc_in;
+
+    // Reorder scratch
+    EpochArray<uint8_t> marks;
+    std::vector<uint32_t> stack;
+    std::vector<uint32_t> forward_set;
+    std::vector<uint32_t> backward_set;
+    std::vector<uint32_t> pool;
+};
+
+}
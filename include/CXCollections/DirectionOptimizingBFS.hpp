@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+class ConnectivityIndex;
+
+// direction-optimizing breadth first search (Beamer et al.) over a CSR graph
+// top-down steps expand the frontier's out edges, bottom-up steps let every unvisited node scan its in edges
+// for a parent in the frontier bitmap and stop at the first hit, which skips most edge checks into already
+// visited nodes once the frontier covers a large part of a low diameter graph
+// each instance holds heap memory for search state, re-use the same object so allocations are reused
+class DirectionOptimizingBFS
+{
+public:
+    // switch to bottom-up when frontier out edges exceed unexplored edges / alpha
+    uint32_t alpha = 15;
+    // switch back to top-down when the frontier shrinks below node count / beta
+    uint32_t beta = 18;
+
+    // full traversal from source, fills Parents() and Depths()
+    // reverse is the transpose of graph (pass graph itself for undirected graphs)
+    void Search(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t source);
+
+    // stops after the level that reaches end, returns path as node ids from end to start or nullptr if no path found
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t start, uint32_t end);
+
+    // optional, queries the index rejects return nullptr without searching (Parents / Depths keep the last
+    // search), nullptr disables
+    inline void SetConnectivityIndex(const ConnectivityIndex* index) { connectivity = index; }
+
+    // per node parent (source is its own parent) and hop count, invalid_node_id if not reached
+    // valid until next search
+    inline const std::vector<uint32_t>& Parents() const { return parents; }
+    inline const std::vector<uint32_t>& Depths() const { return depths; }
+
+    // steps taken in each direction by the last search, for tuning alpha / beta
+    inline uint32_t TopDownSteps() const { return top_down_steps; }
+    inline uint32_t BottomUpSteps() const { return bottom_up_steps; }
+
+private:
+    void Run(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t source, uint32_t target);
+
+    uint64_t StepTopDown(const CSRGraphView& graph, uint32_t depth);
+    uint32_t StepBottomUp(const CSRGraphView& reverse, uint32_t depth);
+
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> depths;
+    std::vector<uint32_t> path;
+
+    // top-down frontier as a node queue, bottom-up frontier as a bitmap
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> next_frontier;
+    std::vector<uint64_t> frontier_bits;
+    std::vector<uint64_t> next_bits;
+    std::vector<uint64_t> visited_bits;
+    std::vector<uint32_t> touched; // nodes reached by the last search, reset by the next one
+
+    uint32_t top_down_steps = 0;
+    uint32_t bottom_up_steps = 0;
+    const ConnectivityIndex* connectivity = nullptr;
+};
+
+}
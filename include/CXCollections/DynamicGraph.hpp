@@ -0,0 +1,121 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+
+#include "CSRGraph.hpp"
+#include "BitOps.hpp"
+
+namespace cyber
+{
+
+// graph taking edge inserts and removals at CSR traversal speed without a rebuild per edit
+// an immutable CSR base is overlaid with a bitmap of removed base edges and per node lists of inserted edges,
+// neighbors are the live base edges in CSR order followed by inserted ones in insertion order
+// once enough edits pile up a background thread merges base and edits into a new CSR base while edits continue,
+// the new base is swapped in by the owning thread (Maintain / FinishMerge) and edits made meanwhile are replayed
+// onto it, so reads never observe a half merged graph and a merge does not change what they see
+// edits, reads and Maintain belong to one thread (or need external locking), only the merge runs concurrently
+class DynamicGraph
+{
+public:
+    // edits pending beyond this make Maintain start a merge
+    uint32_t merge_threshold = 4096;
+
+    DynamicGraph() = default;
+    ~DynamicGraph();
+    DynamicGraph(const DynamicGraph&) = delete;
+    DynamicGraph& operator=(const DynamicGraph&) = delete;
+
+    // copies graph as the base, drops edits and any running merge
+    void Reset(const CSRGraphView& graph);
+
+    void InsertEdge(uint32_t source, uint32_t target, uint32_t weight = 1);
+
+    // removes the first source -> target edge in neighbor order, false if there is none
+    bool RemoveEdge(uint32_t source, uint32_t target);
+
+    inline uint32_t NodeCount() const { return uint32_t(delta_head.size()); }
+    inline uint32_t EdgeCount() const { return live_edges; }
+    uint32_t Degree(uint32_t node) const;
+
+    // calls fn(target, weight) for every out edge of node
+    template<typename Fn>
+    inline void ForEachEdge(uint32_t node, Fn&& fn) const
+    {
+        const CSRGraph& b = *base;
+        const bool weighted = !b.weights.empty();
+        for (uint32_t e = b.offsets[node], eEnd = b.offsets[node + 1]; e != eEnd; ++e)
+        {
+            if (deleted_count == 0 || !TestBit(deleted.data(), e))
+                fn(b.targets[e], weighted ? b.weights[e] : 1u);
+        }
+        for (uint32_t d = delta_head[node]; d != invalid_node_id; d = delta[d].next)
+            fn(delta[d].target, delta[d].weight);
+    }
+
+    // finishes a completed merge and starts one when pending edits exceed merge_threshold, call once per frame
+    // returns true if a new base was installed
+    bool Maintain();
+
+    // false if a merge is already running
+    bool StartMerge();
+
+    // installs the merged base, wait blocks until the merge completes, false if none was ready
+    bool FinishMerge(bool wait);
+
+    inline bool MergeInProgress() const { return merge_thread.joinable(); }
+
+    // inserted plus removed edges not yet folded into the base
+    inline uint32_t PendingEdits() const { return delta_count + deleted_count; }
+
+    // bumped by every edit, merges keep it, e.g. as the graph version of a PathCache
+    inline uint32_t Version() const { return version; }
+
+    // current base, lacks the pending edits
+    inline const CSRGraph& Base() const { return *base; }
+
+private:
+    struct DeltaEdge
+    {
+        uint32_t target;
+        uint32_t weight;
+        uint32_t next;
+    };
+
+    struct Edit
+    {
+        uint32_t source;
+        uint32_t target;
+        uint32_t weight;
+        bool insert;
+    };
+
+    void Insert(uint32_t source, uint32_t target, uint32_t weight);
+    bool Remove(uint32_t source, uint32_t target);
+    void ClearEdits();
+    void JoinMerge();
+    static void Merge(std::shared_ptr<const CSRGraph> base, std::vector<uint64_t> deleted, std::vector<uint32_t> deltaHead,
+        std::vector<DeltaEdge> delta, CSRGraph* out, std::atomic<bool>* ready);
+
+    std::shared_ptr<const CSRGraph> base = std::make_shared<CSRGraph>();
+    std::vector<uint64_t> deleted; // bit per base edge
+    std::vector<uint32_t> delta_head; // per node, first and last inserted edge or invalid_node_id
+    std::vector<uint32_t> delta_tail;
+    std::vector<DeltaEdge> delta; // removed inserts leave holes until the next merge
+    uint32_t deleted_count = 0;
+    uint32_t delta_count = 0;
+    uint32_t live_edges = 0;
+    uint32_t version = 0;
+
+    std::thread merge_thread;
+    std::atomic<bool> merge_ready{ false };
+    std::shared_ptr<CSRGraph> merged;
+    std::vector<Edit> merge_log; // edits made since the running merge took its copy
+};
+
+}
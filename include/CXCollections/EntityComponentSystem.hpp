@@ -10,6 +10,8 @@
 
 #include <any>
 
+#include "Relocate.hpp"
+
 // entity
 // -- component
 // -- component
@@ -62,15 +64,18 @@ struct ComponentGroup
     //Tc& Get(int i) noexcept { return components[i]; }
     
     //std::vector<Tc> components;
-    Tc* components;
+    Tc* components = nullptr;
 
 protected:
     //friend struct Archetype;
-    inline void Grow(size_t cap) {
+    // only the first count components are constructed, the rest of the buffer is raw memory
+    inline void Grow(size_t count, size_t cap) {
         Tc* oldData = components;
         components = (Tc*)operator new(sizeof(Tc) * cap*2, std::align_val_t(alignment));
-        memcpy(components, oldData, cap);
-        operator delete(oldData, std::align_val_t(alignment));
+        if (oldData) {
+            cyber::relocate(components, oldData, count);
+            operator delete(oldData, std::align_val_t(alignment));
+        }
     }
 
     static constexpr size_t alignment = 4096; // standard cache line size
@@ -101,7 +106,7 @@ struct Archetype : ArchetypeBase
     inline ComponentGroup<Tc>& GetComponentGroup() { return std::get<ComponentGroup<Tc>>(componentGroups); }
 
     template<typename Tc>
-    inline Tc& GetComponent(unsigned entity) { return (Tc&)GetComponentGroup<Tc>().components[entity]; }
+    inline Tc& GetComponent(unsigned entity) { return GetComponentArray<Tc>()[entity]; }
 
     template<typename Tc>
     inline Tc* GetComponentArray() { return std::get<Tc*>(componentsTuple); }
@@ -111,11 +116,21 @@ struct Archetype : ArchetypeBase
     //    return std::make_tuple< GetComponentGroup<Tcs>().components[entityIndex], ... >();
     //}
 
+    Archetype() = default;
+    Archetype(const Archetype&) = delete;
+    Archetype& operator=(const Archetype&) = delete;
+
+    ~Archetype() {
+        (FreeComponent<Ts>(), ...);
+    }
+
+    // components are value-initialized, so only constructed components are ever relocated or destroyed
     unsigned CreateEntity() {
+        if (entityCount == entityCapacity || std::get<0>(componentsTuple) == nullptr)
+            Grow();
         unsigned entity = entityCount;
+        (new (GetComponentArray<Ts>() + entity) Ts(), ...);
         ++entityCount;
-        if (entityCount == entityCapacity)
-            Grow();
         return entity;
     }
 
@@ -192,18 +207,30 @@ private:
     //}
 
     template<typename Tc>
-    inline void GrowComponent(size_t capOld) {
+    inline void GrowComponent(size_t capNew) {
         Tc*& dataNew = std::get<Tc*>(componentsTuple);
         Tc* dataOld = dataNew;
-        dataNew = (Tc*)operator new(sizeof(Tc) * capOld * 2, std::align_val_t(4096));
-        memcpy(dataNew, dataOld, sizeof(Tc) * capOld);
-        operator delete(dataOld, std::align_val_t(4096));
+        dataNew = (Tc*)operator new(sizeof(Tc) * capNew, std::align_val_t(4096));
+        if (dataOld) {
+            cyber::relocate(dataNew, dataOld, entityCount); // memcpy only for trivially relocatable components
+            operator delete(dataOld, std::align_val_t(4096));
+        }
+    }
+
+    template<typename Tc>
+    inline void FreeComponent() {
+        Tc* data = std::get<Tc*>(componentsTuple);
+        if (!data)
+            return;
+        cyber::destroy(data, entityCount);
+        operator delete(data, std::align_val_t(4096));
     }
 
+    // the first grow allocates the initial capacity
     void Grow() {
-        unsigned capOld = entityCapacity;
-        (GrowComponent<Ts>(capOld), ...);
-        entityCapacity = capOld * 2;
+        unsigned capNew = std::get<0>(componentsTuple) ? entityCapacity * 2 : entityCapacity;
+        (GrowComponent<Ts>(capNew), ...);
+        entityCapacity = capNew;
     }
 
 private:
@@ -213,7 +240,7 @@ private:
     std::tuple< ComponentGroup<Ts>... > componentGroups;
 
     unsigned* entityId_to_componentsIdx;
-    std::tuple< Ts* ... > componentsTuple;
+    std::tuple< Ts* ... > componentsTuple{}; // null until the first entity
 };
 
 
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace cyber
+{
+
+// dense id-indexed values that are only valid when stamped with the current epoch
+// NextEpoch invalidates every value in O(1), stamps are only rewritten on growth and on 32-bit epoch wraparound
+// stamp and value share an entry so a visited check and its value read touch one cache line
+template<typename T>
+struct EpochArray
+{
+    struct Entry
+    {
+        uint32_t stamp;
+        T value;
+    };
+
+    // invalidates all values and makes room for ids below count
+    inline void NextEpoch(size_t count)
+    {
+        if (entries.size() < count)
+            entries.resize(count, Entry{ 0, T() });
+
+        if (++epoch == 0)
+        {
+            for (Entry& e : entries)
+                e.stamp = 0;
+            epoch = 1;
+        }
+    }
+
+    // grows to hold id, for callers that do not know the id range up front
+    inline void Reserve(uint32_t id)
+    {
+        if (id >= entries.size())
+            entries.resize(size_t(id) + 1 > entries.size() * 2 ? size_t(id) + 1 : entries.size() * 2, Entry{ 0, T() });
+    }
+
+    inline size_t Size() const { return entries.size(); }
+    inline bool Has(uint32_t id) const { return entries[id].stamp == epoch; }
+    inline const T& Get(uint32_t id) const { return entries[id].value; } // only meaningful if Has(id)
+    inline T& operator[](uint32_t id) { return entries[id].value; }
+
+    inline void Set(uint32_t id, const T& value)
+    {
+        Entry& e = entries[id];
+        e.stamp = epoch;
+        e.value = value;
+    }
+
+    // sets and returns true only if id was not yet set this epoch
+    inline bool TrySet(uint32_t id, const T& value)
+    {
+        Entry& e = entries[id];
+        if (e.stamp == epoch)
+            return false;
+        e.stamp = epoch;
+        e.value = value;
+        return true;
+    }
+
+    std::vector<Entry> entries;
+    uint32_t epoch = 0;
+};
+
+}
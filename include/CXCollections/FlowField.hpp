@@ -0,0 +1,58 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+class ParallelBFS;
+
+// distance and next hop towards one goal for every node, for many agents sharing a destination
+// one search from the goal over the transposed graph replaces a FindPathReversed per agent, after which each agent
+// reads its next step in O(1) with NextHop and the whole path by following it
+// takes the reverse graph (BuildTranspose, or the graph itself when undirected), weights are used if present
+class FlowField
+{
+public:
+    static constexpr uint32_t invalid_cost = 0xFFFFFFFF;
+
+    // MoveGoal rebuilds from scratch instead when the repair would need more cost buckets than this
+    uint32_t max_buckets = 1 << 16;
+
+    // BFS for unweighted graphs, Dijkstra otherwise
+    void Build(const CSRGraphView& reverse, uint32_t goal);
+
+    // unweighted graphs only, runs the level synchronous search on bfs's worker pool
+    void Build(ParallelBFS& bfs, const CSRGraphView& reverse, uint32_t goal);
+
+    // recomputes the field for a nearby goal
+    // distances to the old goal are a potential that makes edge costs along the old field zero and keeps every new
+    // reduced distance below the round trip cost between the two goals, so the repair runs over a small array of
+    // cost buckets without a heap, returns false if it had to fall back to Build
+    bool MoveGoal(const CSRGraphView& reverse, uint32_t goal);
+
+    inline uint32_t Goal() const { return goal_node; }
+
+    // cost from node to the goal, invalid_cost if the goal cannot be reached
+    inline uint32_t Distance(uint32_t node) const { return distances[node]; }
+
+    // next node on a cheapest path to the goal, the goal maps to itself, invalid_node_id if the goal cannot be reached
+    inline uint32_t NextHop(uint32_t node) const { return next_hops[node]; }
+
+    inline const std::vector<uint32_t>& Distances() const { return distances; }
+    inline const std::vector<uint32_t>& NextHops() const { return next_hops; }
+
+private:
+    uint32_t goal_node = invalid_node_id;
+    std::vector<uint32_t> distances;
+    std::vector<uint32_t> next_hops;
+
+    // MoveGoal scratch
+    std::vector<uint32_t> reduced;
+    std::vector<std::vector<uint32_t>> buckets;
+};
+
+}
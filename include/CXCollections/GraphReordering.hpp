@@ -0,0 +1,42 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+// node relabeling, new_to_old[newId] = oldId and old_to_new[oldId] = newId
+// results found on a relabeled graph map back to caller ids through new_to_old
+struct NodePermutation
+{
+    std::vector<uint32_t> new_to_old;
+    std::vector<uint32_t> old_to_new;
+
+    // fills old_to_new from new_to_old
+    void Invert();
+};
+
+// locality orderings, each fills perm for every node of graph so that nodes visited close together in a
+// traversal get close ids and their search state shares cache lines, relabel with CSRGraph::BuildPermuted
+// orderings that walk neighborhoods treat edges as undirected (out and in edges)
+
+// reverse Cuthill-McKee, breadth first from a minimum degree node per component visiting lower degree
+// neighbors first, then reversed, keeps edges close to the diagonal (small bandwidth)
+void ReverseCuthillMcKeeOrder(const CSRGraphView& graph, NodePermutation& perm);
+
+// breadth first / depth first preorder from root following out edges, unreached nodes continue from the next
+// unvisited id
+void BFSOrder(const CSRGraphView& graph, uint32_t root, NodePermutation& perm);
+void DFSOrder(const CSRGraphView& graph, uint32_t root, NodePermutation& perm);
+
+// highest out degree first (hubs packed together), stable for equal degrees
+void DegreeSortOrder(const CSRGraphView& graph, NodePermutation& perm);
+
+// greedy Gorder (Wei et al.) lite, each next id goes to the node sharing the most edges and common neighbors with
+// the last window placed nodes, common neighbors through nodes above hubDegree are ignored to bound the cost
+void GorderLiteOrder(const CSRGraphView& graph, NodePermutation& perm, uint32_t window = 5, uint32_t hubDegree = 64);
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace cyber
+{
+
+// bit-packed occupancy grid, one blocked bit per cell, cell ids are y * width + x
+// cells are stored twice, as rows and as columns, so scans along either axis read 64 cells per word
+// every line is padded with blocked words on both ends and the grid with a blocked line on every side,
+// so neighbor reads one cell past the border and 64 cell windows never need bounds checks
+// a fraction of the memory of a materialized 8-neighbor BFSNode graph (2 bits vs ~100 bytes per cell)
+class GridMap
+{
+public:
+    // all cells start free
+    void Resize(uint32_t width, uint32_t height);
+
+    inline uint32_t Width() const { return width; }
+    inline uint32_t Height() const { return height; }
+    inline uint32_t CellCount() const { return width * height; }
+    inline uint32_t CellId(uint32_t x, uint32_t y) const { return y * width + x; }
+    inline uint32_t CellX(uint32_t id) const { return id % width; }
+    inline uint32_t CellY(uint32_t id) const { return id / width; }
+
+    // out of bounds cells read as blocked, down to -1 and up to width / height
+    inline bool IsBlocked(int32_t x, int32_t y) const
+    {
+        const uint64_t* row = Row(y);
+        uint32_t bit = uint32_t(x + 64);
+        return (row[bit >> 6] >> (bit & 63)) & 1;
+    }
+
+    void SetBlocked(uint32_t x, uint32_t y, bool blocked);
+
+    // padded lines for word-wide scans, cell i of a line is bit i + 64, lines exist for -1 .. height / width
+    inline const uint64_t* Row(int32_t y) const { return rows.data() + size_t(y + 1) * row_stride; }
+    inline const uint64_t* Column(int32_t x) const { return columns.data() + size_t(x + 1) * column_stride; }
+
+    inline size_t MemoryBytes() const { return (rows.size() + columns.size()) * sizeof(uint64_t); }
+
+private:
+    static void InitLines(std::vector<uint64_t>& lines, size_t stride, uint32_t lineLength, uint32_t lineCount);
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t row_stride = 0;    // words per padded row
+    size_t column_stride = 0; // words per padded column
+    std::vector<uint64_t> rows;
+    std::vector<uint64_t> columns;
+};
+
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "GridMap.hpp"
+#include "EpochArray.hpp"
+#include "IndexedHeap.hpp"
+
+namespace cyber
+{
+
+// hierarchical path-finding A* (HPA*, Botea et al.) over a GridMap with the same moves and costs as JumpPointSearch
+// the grid is cut into square clusters, free runs along each cluster border become entrances with one or two
+// transition cells per side, and every cluster caches the costs between its transition cells (paths kept inside
+// the cluster), a query links start and end into their clusters, runs A* on that small abstract graph and returns
+// waypoints, RefineSegment turns one waypoint hop into cells only when the caller needs it
+// paths are near optimal, within a few percent, since they must pass through transition cells
+// grid edits call CellChanged, which only marks the cell's cluster (and the neighbor sharing a border cell) dirty,
+// dirty clusters are rebuilt before the next query
+class HierarchicalPathfinder
+{
+public:
+    static constexpr uint32_t invalid_cost = 0xFFFFFFFF;
+
+    // grid must outlive the pathfinder
+    void Build(const GridMap& grid, uint32_t clusterSize = 32);
+
+    // call after changing the blocked state of a grid cell
+    void CellChanged(uint32_t x, uint32_t y);
+
+    // returns waypoints as cell ids from end to start or nullptr if no path found
+    // consecutive waypoints are either neighbors across a cluster border or in the same cluster
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed(uint32_t start, uint32_t end);
+
+    // appends the cells after from up to and including to, for consecutive waypoints of a found path
+    bool RefineSegment(uint32_t from, uint32_t to, std::vector<uint32_t>& cells);
+
+    // every cell along a waypoint path, in the same order
+    void RefinePath(const std::vector<uint32_t>& waypoints, std::vector<uint32_t>& cells);
+
+    // cost of the last path found in JumpPointSearch::straight_cost units, equal to the refined path's cost
+    inline uint32_t PathCost() const { return path_cost; }
+
+    // abstract nodes taken off the open set by the last search
+    inline uint32_t ExpandedNodes() const { return expanded_nodes; }
+
+    // clusters whose cached costs were rebuilt before the last search (all of them after Build)
+    inline uint32_t RebuiltClusters() const { return rebuilt_clusters; }
+
+    uint32_t AbstractNodeCount() const;
+
+private:
+    struct InterEdge
+    {
+        uint32_t local;  // transition cell on this side
+        uint32_t target; // abstract id of the cell across the border
+    };
+
+    struct Cluster
+    {
+        uint32_t x0, y0, width, height;
+        std::vector<uint32_t> cells; // transition cells sorted by id, position is the local index
+        std::vector<uint32_t> intra; // cells.size() squared costs within the cluster, invalid_cost if unreachable
+        std::vector<InterEdge> inter; // sorted by local
+        bool dirty;
+    };
+
+    struct Label
+    {
+        uint32_t cost;
+        uint32_t prev;
+        bool settled;
+    };
+
+    inline uint32_t ClusterOf(uint32_t x, uint32_t y) const { return (y / cluster_size) * clusters_x + x / cluster_size; }
+    inline uint32_t ClusterOfCell(uint32_t cell) const { return ClusterOf(grid->CellX(cell), grid->CellY(cell)); }
+
+    void Flush();
+    // returns true if the cluster's transition cells changed
+    bool CollectCells(uint32_t c);
+    void LinkInter(uint32_t c);
+    void ComputeIntra(uint32_t c);
+    // (first side, second side) cell pairs of the entrances between cluster a and its right or lower neighbor b
+    void BorderTransitions(uint32_t a, uint32_t b, std::vector<uint32_t>& out) const;
+
+    // Dijkstra inside one cluster from source, or A* stopping at target when it is valid
+    bool LocalSearch(uint32_t c, uint32_t source, uint32_t target);
+    uint32_t LocalCost(uint32_t c, uint32_t cell) const;
+
+    uint32_t CellOf(uint32_t id) const;
+    void Relax(uint32_t from, uint32_t to, uint32_t cost);
+
+    const GridMap* grid = nullptr;
+    uint32_t cluster_size = 0;
+    uint32_t clusters_x = 0;
+    uint32_t clusters_y = 0;
+    uint32_t slot_capacity = 0; // abstract ids per cluster, id = cluster * slot_capacity + local
+    std::vector<Cluster> clusters;
+    bool has_dirty = false;
+
+    // abstract search
+    uint32_t start_cell = 0;
+    uint32_t end_cell = 0;
+    uint32_t start_cluster = 0;
+    uint32_t end_cluster = 0;
+    std::vector<uint32_t> start_costs;
+    std::vector<uint32_t> end_costs;
+    uint32_t direct_cost = invalid_cost;
+    IndexedDaryHeap<4> open;
+    EpochArray<Label> labels;
+    std::vector<uint32_t> path;
+    uint32_t path_cost = invalid_cost;
+    uint32_t expanded_nodes = 0;
+    uint32_t rebuilt_clusters = 0;
+    std::vector<bool> relink;
+    std::vector<uint32_t> previous_cells;
+
+    // local searches, indexed by position within the cluster box
+    IndexedDaryHeap<4> local_open;
+    EpochArray<Label> local_labels;
+    std::vector<uint32_t> scratch;
+    std::vector<uint32_t> segment;
+};
+
+}
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <assert.h>
+
+#include "CSRGraph.hpp"
+#include "EpochArray.hpp"
+#include "IndexedHeap.hpp"
+
+namespace cyber
+{
+
+// heuristic between two node ids that turns D* Lite into LPA* style Dijkstra repair
+struct ZeroDistance
+{
+    inline uint32_t operator()(uint32_t, uint32_t) const { return 0; }
+};
+
+struct EdgeCostUpdate
+{
+    uint32_t source;
+    uint32_t target;
+    uint32_t cost; // 0xFFFFFFFF removes the edge
+};
+
+// incremental replanning with D* Lite (Koenig and Likhachev) over a weighted CSR graph
+// keeps g / rhs values between queries and searches from the goal back towards the start, so after edge
+// cost changes only nodes whose distance to the goal changed are re-expanded, and the start may move along
+// the path (MoveStart) without invalidating anything
+// edge costs are copied at Reset and edited through UpdateEdges, invalid_cost removes an edge - the topology
+// is fixed by the graph given to Reset, so links that may appear later must exist there (at invalid_cost)
+// heuristic(a, b) is a lower bound of the cost from a to b and must be consistent
+template<typename Heuristic = ZeroDistance>
+class IncrementalPlanner
+{
+public:
+    static constexpr uint32_t invalid_cost = 0xFFFFFFFF;
+
+    // copies graph structure and costs (1 per edge if unweighted) and plans from start to goal on first query
+    void Reset(const CSRGraphView& graph, uint32_t start, uint32_t goal, Heuristic h = Heuristic())
+    {
+        heuristic = h;
+        node_count = graph.node_count;
+        offsets.assign(graph.offsets, graph.offsets + size_t(graph.node_count) + 1);
+        targets.assign(graph.targets, graph.targets + graph.edge_count);
+        costs.resize(graph.edge_count);
+        for (uint32_t e = 0; e < graph.edge_count; ++e)
+            costs[e] = graph.Weight(e);
+
+        // predecessor lists hold forward edge indices so both directions read one cost array
+        in_offsets.assign(size_t(node_count) + 1, 0);
+        for (uint32_t e = 0; e < graph.edge_count; ++e)
+            ++in_offsets[targets[e] + 1];
+        for (uint32_t n = 0; n < node_count; ++n)
+            in_offsets[n + 1] += in_offsets[n];
+        in_edges.resize(graph.edge_count);
+        in_sources.resize(graph.edge_count);
+        std::vector<uint32_t> cursor(in_offsets.begin(), in_offsets.end() - 1);
+        for (uint32_t n = 0; n < node_count; ++n)
+        {
+            for (uint32_t e = offsets[n]; e != offsets[n + 1]; ++e)
+            {
+                uint32_t slot = cursor[targets[e]]++;
+                in_edges[slot] = e;
+                in_sources[slot] = n;
+            }
+        }
+
+        g.assign(node_count, invalid_cost);
+        rhs.assign(node_count, invalid_cost);
+        open.reset(node_count);
+        start_node = start;
+        last_start = start;
+        goal_node = goal;
+        km = 0;
+        expanded_nodes = 0;
+
+        rhs[goal] = 0;
+        open.push(goal, Key(goal));
+    }
+
+    // the agent moved, e.g. to the next node of the last path
+    void MoveStart(uint32_t start)
+    {
+        km = Add(km, heuristic(last_start, start));
+        last_start = start;
+        start_node = start;
+    }
+
+    // applies a batch of cost changes, the repair work happens on the next FindPathReversed
+    // each update changes the first source -> target edge
+    void UpdateEdges(const EdgeCostUpdate* updates, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const EdgeCostUpdate& update = updates[i];
+            uint32_t e = FindEdge(update.source, update.target);
+            assert(e != invalid_node_id && "edge must exist in the graph given to Reset");
+
+            uint32_t oldCost = costs[e];
+            if (oldCost == update.cost)
+                continue;
+            costs[e] = update.cost;
+
+            uint32_t u = update.source, v = update.target;
+            if (u == goal_node)
+                continue;
+            if (update.cost < oldCost)
+                rhs[u] = std::min(rhs[u], Add(update.cost, g[v]));
+            else if (rhs[u] == Add(oldCost, g[v]))
+                rhs[u] = BestSuccessor(u);
+            UpdateVertex(u);
+        }
+    }
+
+    // repairs the search and returns the path as node ids from goal to start or nullptr if the goal is unreachable
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed()
+    {
+        expanded_nodes = 0;
+        ComputeShortestPath();
+
+        path.clear();
+        path_cost = rhs[start_node];
+        if (path_cost == invalid_cost)
+            return nullptr;
+
+        // zero cost cycles can stall the greedy walk, the tight edge search always finds the goal on consistent g
+        if (!WalkDownhill() && !TightEdgePath())
+        {
+            assert(false && "g does not lead from the start to the goal");
+            path.clear();
+            return nullptr;
+        }
+        return &path;
+    }
+
+    inline uint32_t PathCost() const { return path_cost; }
+
+    // nodes expanded by the last FindPathReversed, the repair work
+    inline uint32_t ExpandedNodes() const { return expanded_nodes; }
+
+    // current cost of the first source -> target edge, invalid_cost if removed or absent
+    inline uint32_t EdgeCost(uint32_t source, uint32_t target) const
+    {
+        uint32_t e = FindEdge(source, target);
+        return e == invalid_node_id ? invalid_cost : costs[e];
+    }
+
+private:
+    // saturating, invalid_cost is infinity
+    static inline uint32_t Add(uint32_t a, uint32_t b)
+    {
+        uint64_t sum = uint64_t(a) + b;
+        return sum >= invalid_cost ? invalid_cost : uint32_t(sum);
+    }
+
+    // [min(g, rhs) + h(start, s) + km, min(g, rhs)] packed so the heap compares it lexicographically
+    inline uint64_t Key(uint32_t s) const
+    {
+        uint32_t m = std::min(g[s], rhs[s]);
+        return (uint64_t(Add(Add(m, heuristic(start_node, s)), km)) << 32) | m;
+    }
+
+    inline uint32_t FindEdge(uint32_t source, uint32_t target) const
+    {
+        for (uint32_t e = offsets[source]; e != offsets[source + 1]; ++e)
+        {
+            if (targets[e] == target)
+                return e;
+        }
+        return invalid_node_id;
+    }
+
+    inline uint32_t BestSuccessor(uint32_t u) const
+    {
+        uint32_t best = invalid_cost;
+        for (uint32_t e = offsets[u]; e != offsets[u + 1]; ++e)
+            best = std::min(best, Add(costs[e], g[targets[e]]));
+        return best;
+    }
+
+    inline void UpdateVertex(uint32_t u)
+    {
+        bool queued = open.contains(u);
+        if (g[u] != rhs[u])
+        {
+            if (queued)
+                open.update(u, Key(u));
+            else
+                open.push(u, Key(u));
+        }
+        else if (queued)
+        {
+            open.erase(u);
+        }
+    }
+
+    // walks downhill in g from the start, ties go to the successor nearer the goal and visited nodes are skipped
+    // returns false without a path when every remaining tight successor was already visited
+    bool WalkDownhill()
+    {
+        marks.NextEpoch(node_count);
+        uint32_t cur = start_node;
+        marks.Set(cur, invalid_node_id);
+        path.push_back(cur);
+        while (cur != goal_node && path.size() <= node_count)
+        {
+            uint32_t best = invalid_cost, bestG = invalid_cost, next = invalid_node_id;
+            for (uint32_t e = offsets[cur]; e != offsets[cur + 1]; ++e)
+            {
+                uint32_t t = targets[e];
+                uint32_t cost = Add(costs[e], g[t]);
+                if (marks.Has(t) || cost == invalid_cost)
+                    continue;
+                if (cost < best || (cost == best && g[t] < bestG))
+                {
+                    best = cost;
+                    bestG = g[t];
+                    next = t;
+                }
+            }
+            if (next == invalid_node_id || best != rhs[cur])
+            {
+                path.clear();
+                return false;
+            }
+            cur = next;
+            marks.Set(cur, invalid_node_id);
+            path.push_back(cur);
+        }
+        if (cur != goal_node)
+        {
+            path.clear();
+            return false;
+        }
+        // flip to match the other searches' order
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+
+    // breadth first search from the start over edges with cost + g[target] == rhs[source], each node is entered once
+    // so zero cost cycles terminate, the path comes out goal to start from the parent links
+    bool TightEdgePath()
+    {
+        marks.NextEpoch(node_count);
+        frontier.clear();
+        marks.Set(start_node, invalid_node_id);
+        frontier.push_back(start_node);
+        for (size_t i = 0; i != frontier.size() && !marks.Has(goal_node); ++i)
+        {
+            uint32_t u = frontier[i];
+            if (rhs[u] == invalid_cost)
+                continue;
+            for (uint32_t e = offsets[u]; e != offsets[u + 1]; ++e)
+            {
+                uint32_t t = targets[e];
+                if (Add(costs[e], g[t]) == rhs[u] && marks.TrySet(t, u))
+                    frontier.push_back(t);
+            }
+        }
+        if (!marks.Has(goal_node))
+            return false;
+
+        for (uint32_t cur = goal_node; cur != invalid_node_id; cur = marks.Get(cur))
+        {
+            assert(path.size() < node_count);
+            path.push_back(cur);
+        }
+        return true;
+    }
+
+    void ComputeShortestPath()
+    {
+        while (!open.empty())
+        {
+            uint32_t u;
+            uint64_t oldKey;
+            open.top(u, oldKey);
+            if (oldKey >= Key(start_node) && rhs[start_node] <= g[start_node])
+                break;
+
+            ++expanded_nodes;
+            uint64_t newKey = Key(u);
+            if (oldKey < newKey)
+            {
+                open.update(u, newKey);
+            }
+            else if (g[u] > rhs[u])
+            {
+                // overconsistent, settle and lower predecessors
+                g[u] = rhs[u];
+                open.erase(u);
+                for (uint32_t i = in_offsets[u]; i != in_offsets[u + 1]; ++i)
+                {
+                    uint32_t e = in_edges[i];
+                    uint32_t s = in_sources[i];
+                    if (s != goal_node)
+                        rhs[s] = std::min(rhs[s], Add(costs[e], g[u]));
+                    UpdateVertex(s);
+                }
+            }
+            else
+            {
+                // underconsistent, raise and recompute everything that went through u
+                uint32_t oldG = g[u];
+                g[u] = invalid_cost;
+                for (uint32_t i = in_offsets[u]; i != in_offsets[u + 1]; ++i)
+                {
+                    uint32_t e = in_edges[i];
+                    uint32_t s = in_sources[i];
+                    if (s != goal_node && rhs[s] == Add(costs[e], oldG))
+                        rhs[s] = BestSuccessor(s);
+                    UpdateVertex(s);
+                }
+                if (u != goal_node)
+                    rhs[u] = BestSuccessor(u);
+                UpdateVertex(u);
+            }
+        }
+    }
+
+    Heuristic heuristic;
+    uint32_t node_count = 0;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> targets;
+    std::vector<uint32_t> costs;
+    std::vector<uint32_t> in_offsets;
+    std::vector<uint32_t> in_edges; // forward edge index per predecessor slot
+    std::vector<uint32_t> in_sources;
+
+    std::vector<uint32_t> g;
+    std::vector<uint32_t> rhs;
+    IndexedDaryHeap<4, uint64_t> open;
+    uint32_t start_node = 0;
+    uint32_t last_start = 0;
+    uint32_t goal_node = 0;
+    uint32_t km = 0;
+
+    std::vector<uint32_t> path;
+    EpochArray<uint32_t> marks; // visited / parent node of the path extraction
+    std::vector<uint32_t> frontier;
+    uint32_t path_cost = invalid_cost;
+    uint32_t expanded_nodes = 0;
+};
+
+}
@@ -0,0 +1,237 @@
+// MIT License - CXCollections
+// Copyright(c) 2020 Dante Falcone (dantefalcone@gmail.com)
+
+#ifndef CX_INDEXED_HEAP_H
+#define CX_INDEXED_HEAP_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <assert.h>
+
+#include "EpochArray.hpp"
+#include "BitOps.hpp"
+
+// min priority queues of dense uint32 ids keyed by costs, the open set of shortest path searches
+// both share one interface so searches are templated on the queue:
+//   reset(idCount)  - empties the queue in O(1) amortized, idCount is a sizing hint (0 if unknown)
+//   push(id, key)   - inserts id, or lowers its key if already queued
+//   pop(id, key)    - removes a minimum entry
+// RadixHeap may hand back an id more than once (its older, larger keys), callers skip entries already settled
+
+namespace cyber
+{
+    // d-ary heap with a per-id position index for in-place decrease key
+    // a wider node halves the depth of a binary heap, and the children scanned on sift down share a cache line
+    // incremental searches also use contains / top / update / erase, with composite keys packed into a uint64_t
+    template<uint32_t arity = 4, typename Key = uint32_t>
+    class IndexedDaryHeap
+    {
+        static_assert(arity >= 2, "heap arity must be at least 2");
+
+    public:
+        inline size_t size() const noexcept { return heap.size(); }
+        inline bool empty() const noexcept { return heap.empty(); }
+
+        inline void reset(size_t idCount)
+        {
+            heap.clear();
+            positions.NextEpoch(idCount);
+        }
+
+        inline bool contains(uint32_t id) const noexcept
+        {
+            return id < positions.Size() && positions.Has(id) && positions.Get(id) != popped;
+        }
+
+        inline void top(uint32_t& id, Key& key) const noexcept
+        {
+            assert(!heap.empty());
+            id = heap[0].id;
+            key = heap[0].key;
+        }
+
+        void push(uint32_t id, Key key)
+        {
+            positions.Reserve(id);
+            if (positions.Has(id) && positions.Get(id) != popped)
+            {
+                uint32_t i = positions.Get(id);
+                if (key < heap[i].key)
+                {
+                    heap[i].key = key;
+                    sift_up(i);
+                }
+                return;
+            }
+
+            heap.push_back(Item{ key, id });
+            sift_up(uint32_t(heap.size() - 1));
+        }
+
+        void pop(uint32_t& id, Key& key) noexcept
+        {
+            top(id, key);
+            erase(id);
+        }
+
+        // sets the key of a queued id in either direction
+        void update(uint32_t id, Key key) noexcept
+        {
+            assert(contains(id));
+            uint32_t i = positions.Get(id);
+            Key old = heap[i].key;
+            heap[i].key = key;
+            if (key < old)
+                sift_up(i);
+            else
+                sift_down(i);
+        }
+
+        // removes a queued id
+        void erase(uint32_t id) noexcept
+        {
+            assert(contains(id));
+            uint32_t i = positions.Get(id);
+            positions.Set(id, popped);
+
+            Item last = heap.back();
+            heap.pop_back();
+            if (i == heap.size())
+                return;
+
+            heap[i] = last;
+            positions.Set(last.id, i);
+            if (i > 0 && last.key < heap[(i - 1) / arity].key)
+                sift_up(i);
+            else
+                sift_down(i);
+        }
+
+    private:
+        struct Item
+        {
+            Key key;
+            uint32_t id;
+        };
+
+        static constexpr uint32_t popped = 0xFFFFFFFF;
+
+        void sift_up(uint32_t i) noexcept
+        {
+            Item item = heap[i];
+            while (i > 0)
+            {
+                uint32_t parent = (i - 1) / arity;
+                if (!(item.key < heap[parent].key))
+                    break;
+                heap[i] = heap[parent];
+                positions.Set(heap[i].id, i);
+                i = parent;
+            }
+            heap[i] = item;
+            positions.Set(item.id, i);
+        }
+
+        void sift_down(uint32_t i) noexcept
+        {
+            Item item = heap[i];
+            const uint32_t count = uint32_t(heap.size());
+            for (;;)
+            {
+                uint32_t first = i * arity + 1;
+                if (first >= count)
+                    break;
+
+                uint32_t last = first + arity < count ? first + arity : count;
+                uint32_t best = first;
+                for (uint32_t c = first + 1; c < last; ++c)
+                {
+                    if (heap[c].key < heap[best].key)
+                        best = c;
+                }
+
+                if (!(heap[best].key < item.key))
+                    break;
+                heap[i] = heap[best];
+                positions.Set(heap[i].id, i);
+                i = best;
+            }
+            heap[i] = item;
+            positions.Set(item.id, i);
+        }
+
+        std::vector<Item> heap;
+        EpochArray<uint32_t> positions; // heap index per id, popped once removed
+    };
+
+    // monotone integer priority queue (Ahuja et al.), pushed keys must not be below the last popped key
+    // which holds for Dijkstra and for A* with a consistent heuristic
+    // bucket b holds keys whose highest bit differing from the last popped key is b - 1, so each entry moves
+    // down at most 32 times over its life and push is O(1) with no position index or decrease key
+    class RadixHeap
+    {
+    public:
+        inline size_t size() const noexcept { return count; }
+        inline bool empty() const noexcept { return count == 0; }
+
+        inline void reset(size_t)
+        {
+            for (std::vector<Item>& bucket : buckets)
+                bucket.clear();
+            last = 0;
+            count = 0;
+        }
+
+        // an already queued id is pushed again, the stale larger entry is left for the caller to skip
+        inline void push(uint32_t id, uint32_t key)
+        {
+            assert(key >= last && "radix heap keys must be monotone");
+            buckets[bucket_of(key)].push_back(Item{ key, id });
+            ++count;
+        }
+
+        void pop(uint32_t& id, uint32_t& key) noexcept
+        {
+            assert(count != 0);
+            if (buckets[0].empty())
+            {
+                uint32_t b = 1;
+                while (buckets[b].empty())
+                    ++b;
+
+                // new minimum becomes the reference point, every entry of its bucket lands in a lower one
+                std::vector<Item>& from = buckets[b];
+                uint32_t minKey = from[0].key;
+                for (const Item& item : from)
+                    minKey = item.key < minKey ? item.key : minKey;
+
+                last = minKey;
+                for (const Item& item : from)
+                    buckets[bucket_of(item.key)].push_back(item);
+                from.clear();
+            }
+
+            Item item = buckets[0].back();
+            buckets[0].pop_back();
+            --count;
+            id = item.id;
+            key = item.key;
+        }
+
+    private:
+        struct Item
+        {
+            uint32_t key;
+            uint32_t id;
+        };
+
+        inline uint32_t bucket_of(uint32_t key) const noexcept { return BitWidth32(key ^ last); }
+
+        std::vector<Item> buckets[33];
+        uint32_t last = 0;
+        size_t count = 0;
+    };
+}
+
+#endif // CX_INDEXED_HEAP_H
@@ -0,0 +1,398 @@
+// MIT License - CXCollections
+// Copyright(c) 2020 Dante Falcone (dantefalcone@gmail.com)
+
+#ifndef CX_INTRUSIVE_H
+#define CX_INTRUSIVE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <functional>
+#include <utility>
+#include <assert.h>
+
+// intrusive containers link objects through hooks embedded in the objects themselves
+// the containers never allocate per element and never own the objects, so pooled objects (StaticPoolAllocator)
+// can be members of several containers at once, one hook per container membership
+// an object must be removed from every container before it is destroyed or returned to its pool
+
+namespace cyber
+{
+    namespace _ {
+        // byte offset of a hook member within T, measured on a live item since a member pointer alone does not give it
+        // containers record it when an item is linked, any hook they later map back to an owner was linked that way
+        template<typename T, typename Hook, Hook T::* member>
+        inline ptrdiff_t hook_offset(const T& item) noexcept
+        {
+            return reinterpret_cast<const unsigned char*>(&(item.*member)) - reinterpret_cast<const unsigned char*>(&item);
+        }
+
+        template<typename T, typename Hook>
+        inline T* hook_owner(Hook* hook, ptrdiff_t offset) noexcept
+        {
+            return reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(hook) - offset);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    // list
+
+    struct IntrusiveListHook
+    {
+        IntrusiveListHook* prev = nullptr;
+        IntrusiveListHook* next = nullptr;
+
+        inline bool is_linked() const noexcept { return next != nullptr; }
+
+        // removes from whatever list this is in, list size must be fixed up by the caller - prefer IntrusiveList::erase
+        inline void unlink() noexcept
+        {
+            prev->next = next;
+            next->prev = prev;
+            prev = next = nullptr;
+        }
+    };
+
+    // doubly linked circular list with a sentinel, O(1) insert / erase / move without allocation
+    template<typename T, IntrusiveListHook T::* hook>
+    class IntrusiveList
+    {
+    public:
+        class iterator
+        {
+            friend class IntrusiveList;
+            IntrusiveListHook* node;
+            ptrdiff_t offset;
+            iterator(IntrusiveListHook* n, ptrdiff_t o) noexcept : node(n), offset(o) {}
+
+        public:
+            inline T& operator*() const noexcept { return *_::hook_owner<T>(node, offset); }
+            inline T* operator->() const noexcept { return _::hook_owner<T>(node, offset); }
+            inline iterator& operator++() noexcept { node = node->next; return *this; }
+            inline iterator& operator--() noexcept { node = node->prev; return *this; }
+            inline bool operator==(const iterator& rhs) const noexcept { return node == rhs.node; }
+            inline bool operator!=(const iterator& rhs) const noexcept { return node != rhs.node; }
+        };
+
+        IntrusiveList() noexcept { sentinel.prev = sentinel.next = &sentinel; }
+        IntrusiveList(const IntrusiveList&) = delete; // elements link back to the sentinel
+        IntrusiveList& operator=(const IntrusiveList&) = delete;
+        ~IntrusiveList() noexcept { clear(); }
+
+        inline size_t size() const noexcept { return count; }
+        inline bool empty() const noexcept { return count == 0; }
+
+        inline iterator begin() noexcept { return iterator(sentinel.next, offset); }
+        inline iterator end() noexcept { return iterator(&sentinel, offset); }
+
+        inline T& front() noexcept { assert(count); return *_::hook_owner<T>(sentinel.next, offset); }
+        inline T& back() noexcept { assert(count); return *_::hook_owner<T>(sentinel.prev, offset); }
+
+        inline void push_front(T& item) noexcept { link_before(sentinel.next, item); }
+        inline void push_back(T& item) noexcept { link_before(&sentinel, item); }
+        inline void insert(iterator pos, T& item) noexcept { link_before(pos.node, item); }
+
+        inline void erase(T& item) noexcept
+        {
+            assert((item.*hook).is_linked());
+            (item.*hook).unlink();
+            --count;
+        }
+
+        inline T& pop_front() noexcept { T& item = front(); erase(item); return item; }
+        inline T& pop_back() noexcept { T& item = back(); erase(item); return item; }
+
+        // relinks an element of this list at the front, LRU touch
+        inline void move_to_front(T& item) noexcept
+        {
+            (item.*hook).unlink();
+            --count;
+            link_before(sentinel.next, item);
+        }
+
+        // unlinks all elements, objects are untouched
+        void clear() noexcept
+        {
+            IntrusiveListHook* h = sentinel.next;
+            while (h != &sentinel)
+            {
+                IntrusiveListHook* next = h->next;
+                h->prev = h->next = nullptr;
+                h = next;
+            }
+            sentinel.prev = sentinel.next = &sentinel;
+            count = 0;
+        }
+
+    private:
+        inline void link_before(IntrusiveListHook* pos, T& item) noexcept
+        {
+            IntrusiveListHook* h = &(item.*hook);
+            assert(!h->is_linked() && "hook already in a list");
+            offset = _::hook_offset<T, IntrusiveListHook, hook>(item);
+            h->next = pos;
+            h->prev = pos->prev;
+            pos->prev->next = h;
+            pos->prev = h;
+            ++count;
+        }
+
+        IntrusiveListHook sentinel;
+        size_t count = 0;
+        ptrdiff_t offset = 0;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    // hash set
+
+    struct IntrusiveHashHook
+    {
+        IntrusiveHashHook* next = nullptr;
+        size_t hash = 0;
+    };
+
+    // chained hash set keyed by KeyOf(item), chains run through the hooks so only the bucket array is allocated
+    // bucket count is a power of two and doubles when the load factor passes 1
+    template<typename T, IntrusiveHashHook T::* hook, typename KeyOf, typename Hash = std::hash<typename std::decay<decltype(KeyOf()(std::declval<const T&>()))>::type>, typename Equal = std::equal_to<typename std::decay<decltype(KeyOf()(std::declval<const T&>()))>::type>>
+    class IntrusiveHashSet
+    {
+    public:
+        using key_type = typename std::decay<decltype(KeyOf()(std::declval<const T&>()))>::type;
+
+        IntrusiveHashSet() = default;
+        IntrusiveHashSet(const IntrusiveHashSet&) = delete;
+        IntrusiveHashSet& operator=(const IntrusiveHashSet&) = delete;
+        ~IntrusiveHashSet() noexcept { clear(); }
+
+        inline size_t size() const noexcept { return count; }
+        inline bool empty() const noexcept { return count == 0; }
+
+        T* find(const key_type& key) const noexcept
+        {
+            if (count == 0)
+                return nullptr;
+
+            size_t h = hasher(key);
+            for (IntrusiveHashHook* n = buckets[h & (buckets.size() - 1)]; n; n = n->next)
+            {
+                T* item = _::hook_owner<T>(n, offset);
+                if (n->hash == h && equal(key_of(*item), key))
+                    return item;
+            }
+            return nullptr;
+        }
+
+        // returns false and leaves the set unchanged if an item with an equal key is present
+        bool insert(T& item)
+        {
+            const key_type& key = key_of(item);
+            if (find(key))
+                return false;
+
+            if (count + 1 > buckets.size())
+                rehash(buckets.empty() ? 16 : buckets.size() * 2);
+
+            offset = _::hook_offset<T, IntrusiveHashHook, hook>(item);
+            IntrusiveHashHook* h = &(item.*hook);
+            h->hash = hasher(key);
+            IntrusiveHashHook*& bucket = buckets[h->hash & (buckets.size() - 1)];
+            h->next = bucket;
+            bucket = h;
+            ++count;
+            return true;
+        }
+
+        // item must be in this set
+        void erase(T& item) noexcept
+        {
+            IntrusiveHashHook* h = &(item.*hook);
+            IntrusiveHashHook** link = &buckets[h->hash & (buckets.size() - 1)];
+            while (*link != h)
+            {
+                assert(*link && "item not in hash set");
+                link = &(*link)->next;
+            }
+            *link = h->next;
+            h->next = nullptr;
+            --count;
+        }
+
+        // unlinks all items, keeps the bucket array
+        void clear() noexcept
+        {
+            for (IntrusiveHashHook*& bucket : buckets)
+            {
+                while (bucket)
+                {
+                    IntrusiveHashHook* next = bucket->next;
+                    bucket->next = nullptr;
+                    bucket = next;
+                }
+            }
+            count = 0;
+        }
+
+        // calls fn(T&) for each item in bucket order, fn must not insert or erase
+        template<typename Fn>
+        void for_each(Fn&& fn) const
+        {
+            for (IntrusiveHashHook* bucket : buckets)
+                for (IntrusiveHashHook* n = bucket; n; n = n->next)
+                    fn(*_::hook_owner<T>(n, offset));
+        }
+
+    private:
+        void rehash(size_t bucket_count)
+        {
+            std::vector<IntrusiveHashHook*> rehashed(bucket_count, nullptr);
+            for (IntrusiveHashHook* bucket : buckets)
+            {
+                while (bucket)
+                {
+                    IntrusiveHashHook* next = bucket->next;
+                    IntrusiveHashHook*& dst = rehashed[bucket->hash & (bucket_count - 1)];
+                    bucket->next = dst;
+                    dst = bucket;
+                    bucket = next;
+                }
+            }
+            buckets.swap(rehashed);
+        }
+
+        std::vector<IntrusiveHashHook*> buckets;
+        size_t count = 0;
+        ptrdiff_t offset = 0;
+        KeyOf key_of;
+        Hash hasher;
+        Equal equal;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////////////////////////////
+    // heap
+
+    struct IntrusiveHeapHook
+    {
+        static constexpr uint32_t invalid_index = 0xFFFFFFFF;
+        uint32_t index = invalid_index;
+
+        inline bool is_linked() const noexcept { return index != invalid_index; }
+    };
+
+    // d-ary min heap by Compare (top is the element no other is ordered before), hooks track heap position
+    // so erase and priority update of any element are O(log n), 4-ary keeps sibling compares in one cache line
+    template<typename T, IntrusiveHeapHook T::* hook, typename Compare = std::less<T>, uint32_t arity = 4>
+    class IntrusiveHeap
+    {
+        static_assert(arity >= 2, "heap arity must be at least 2");
+
+    public:
+        IntrusiveHeap() = default;
+        IntrusiveHeap(const IntrusiveHeap&) = delete;
+        IntrusiveHeap& operator=(const IntrusiveHeap&) = delete;
+        ~IntrusiveHeap() noexcept { clear(); }
+
+        inline size_t size() const noexcept { return heap.size(); }
+        inline bool empty() const noexcept { return heap.empty(); }
+        inline T& top() const noexcept { assert(!heap.empty()); return *heap[0]; }
+
+        void push(T& item)
+        {
+            assert(!(item.*hook).is_linked() && "item already in a heap");
+            heap.push_back(&item);
+            sift_up(uint32_t(heap.size() - 1));
+        }
+
+        T& pop() noexcept
+        {
+            T& item = top();
+            erase(item);
+            return item;
+        }
+
+        // item must be in this heap
+        void erase(T& item) noexcept
+        {
+            uint32_t i = (item.*hook).index;
+            assert(i < heap.size() && heap[i] == &item);
+            (item.*hook).index = IntrusiveHeapHook::invalid_index;
+
+            T* last = heap.back();
+            heap.pop_back();
+            if (last == &item)
+                return;
+
+            place(i, last);
+            update_at(i);
+        }
+
+        // restores heap order after the item's priority changed in either direction
+        inline void update(T& item) noexcept { update_at((item.*hook).index); }
+
+        void clear() noexcept
+        {
+            for (T* item : heap)
+                (item->*hook).index = IntrusiveHeapHook::invalid_index;
+            heap.clear();
+        }
+
+    private:
+        inline void place(uint32_t i, T* item) noexcept
+        {
+            heap[i] = item;
+            (item->*hook).index = i;
+        }
+
+        inline void update_at(uint32_t i) noexcept
+        {
+            if (i > 0 && comp(*heap[i], *heap[(i - 1) / arity]))
+                sift_up(i);
+            else
+                sift_down(i);
+        }
+
+        void sift_up(uint32_t i) noexcept
+        {
+            T* item = heap[i];
+            while (i > 0)
+            {
+                uint32_t parent = (i - 1) / arity;
+                if (!comp(*item, *heap[parent]))
+                    break;
+                place(i, heap[parent]);
+                i = parent;
+            }
+            place(i, item);
+        }
+
+        void sift_down(uint32_t i) noexcept
+        {
+            T* item = heap[i];
+            uint32_t n = uint32_t(heap.size());
+            for (;;)
+            {
+                uint32_t first = i * arity + 1;
+                if (first >= n)
+                    break;
+
+                uint32_t last = first + arity < n ? first + arity : n;
+                uint32_t best = first;
+                for (uint32_t c = first + 1; c < last; ++c)
+                {
+                    if (comp(*heap[c], *heap[best]))
+                        best = c;
+                }
+
+                if (!comp(*heap[best], *item))
+                    break;
+                place(i, heap[best]);
+                i = best;
+            }
+            place(i, item);
+        }
+
+        std::vector<T*> heap;
+        Compare comp;
+    };
+}
+
+#endif // !CX_INTRUSIVE_H
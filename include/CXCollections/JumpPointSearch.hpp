@@ -0,0 +1,65 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+#include "GridMap.hpp"
+#include "EpochArray.hpp"
+#include "IndexedHeap.hpp"
+
+namespace cyber
+{
+
+// jump point search (Harabor and Grastien) on an 8-connected uniform cost GridMap, no explicit graph
+// diagonal moves need both adjacent orthogonal cells free (no corner cutting), costs are octile in fixed point
+// A* only expands jump points - cells where the optimal path may turn - and the straight jumps between them are
+// word-wide bitboard scans, 64 cells per step over the grid's row or column bits
+// each instance holds heap memory for search state, re-use the same object so allocations are reused
+class JumpPointSearch
+{
+public:
+    static constexpr uint32_t straight_cost = 1000;
+    static constexpr uint32_t diagonal_cost = 1414;
+
+    // returns jump points as cell ids from end to start or nullptr if no path found
+    // consecutive waypoints are joined by a straight or diagonal line, ExpandPath fills in the cells between
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed(const GridMap& grid, uint32_t start, uint32_t end);
+
+    // cost of the last path found in straight_cost units
+    inline uint32_t PathCost() const { return path_cost; }
+
+    // jump points taken off the open set by the last search
+    inline uint32_t ExpandedNodes() const { return expanded_nodes; }
+
+    // every cell along a waypoint path, in the same order
+    static void ExpandPath(const GridMap& grid, const std::vector<uint32_t>& waypoints, std::vector<uint32_t>& cells);
+
+    // octile distance, exact on an empty grid and the A* heuristic
+    static uint32_t OctileDistance(int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+
+private:
+    struct Label
+    {
+        uint32_t cost;
+        uint32_t prev; // cell id, start links to itself
+        bool settled;
+    };
+
+    // returns jump point cell id reached from (x, y) moving (dx, dy), or invalid_node_id
+    uint32_t Jump(int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+    uint32_t JumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy) const;
+    void Relax(uint32_t from, uint32_t to);
+
+    const GridMap* grid = nullptr;
+    int32_t goal_x = 0;
+    int32_t goal_y = 0;
+
+    IndexedDaryHeap<4> open;
+    EpochArray<Label> labels;
+    std::vector<uint32_t> path;
+    uint32_t path_cost = 0;
+    uint32_t expanded_nodes = 0;
+};
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+class LandmarkIndex;
+
+// A* heuristic towards one target, see LandmarkIndex::Heuristic
+struct LandmarkHeuristic
+{
+    const LandmarkIndex* index;
+    uint32_t target;
+
+    inline uint32_t operator()(uint32_t node) const;
+};
+
+// ALT (A*, landmarks, triangle inequality, Goldberg and Harrelson) preprocessing for goal directed search on graphs
+// without coordinates
+// stores distances from and to K landmarks for every node, and by the triangle inequality
+//   d(v, t) >= d(v, L) - d(t, L)  and  d(v, t) >= d(L, t) - d(L, v)
+// the best of these over all landmarks is a consistent lower bound usable with ShortestPathSearch
+// landmarks are picked farthest first, each next one maximizes its round trip distance to the closest landmark
+// so far (nodes no landmark reaches first), which spreads them over the graph's periphery where bounds are tight
+// distances are kept node major in 16-bit when every finite distance fits, 32-bit otherwise
+class LandmarkIndex
+{
+public:
+    // graph and its transpose (graph itself when undirected), weights are used if present
+    // the first landmark is the node farthest from seed
+    void Build(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t landmarkCount, uint32_t seed = 0);
+
+    // lower bound of the cost from node to target, consistent for a fixed target
+    // nodes the landmarks prove cannot reach target get a bound above every real one
+    inline uint32_t LowerBound(uint32_t node, uint32_t target) const
+    {
+        return compact ? Bound(near_from.data(), near_to.data(), uint16_t(0xFFFF), node, target)
+                       : Bound(far_from.data(), far_to.data(), uint32_t(0xFFFFFFFF), node, target);
+    }
+
+    inline LandmarkHeuristic Heuristic(uint32_t target) const { return LandmarkHeuristic{ this, target }; }
+
+    inline uint32_t LandmarkCount() const { return uint32_t(landmarks.size()); }
+    inline const std::vector<uint32_t>& Landmarks() const { return landmarks; }
+
+    // true when distances are stored in 16 bits
+    inline bool IsCompact() const { return compact; }
+    size_t MemoryBytes() const;
+
+private:
+    template<typename T>
+    inline uint32_t Bound(const T* from, const T* to, T unreachable, uint32_t node, uint32_t target) const
+    {
+        const size_t k = landmarks.size();
+        const T* fromNode = from + node * k;
+        const T* fromTarget = from + target * k;
+        const T* toNode = to + node * k;
+        const T* toTarget = to + target * k;
+
+        uint32_t best = 0;
+        for (size_t i = 0; i < k; ++i)
+        {
+            // d(v, t) >= d(v, L) - d(t, L)
+            if (toTarget[i] != unreachable)
+            {
+                if (toNode[i] == unreachable)
+                    return dead_bound; // t reaches L but v does not, so v cannot reach t
+                if (toNode[i] > toTarget[i] && uint32_t(toNode[i] - toTarget[i]) > best)
+                    best = uint32_t(toNode[i] - toTarget[i]);
+            }
+
+            // d(v, t) >= d(L, t) - d(L, v)
+            if (fromNode[i] != unreachable)
+            {
+                if (fromTarget[i] == unreachable)
+                    return dead_bound; // L reaches v but not t, so v cannot reach t
+                if (fromTarget[i] > fromNode[i] && uint32_t(fromTarget[i] - fromNode[i]) > best)
+                    best = uint32_t(fromTarget[i] - fromNode[i]);
+            }
+        }
+        return best;
+    }
+
+    std::vector<uint32_t> landmarks;
+    bool compact = false;
+    uint32_t dead_bound = 0; // above every finite landmark distance, keeps the bound consistent on dead ends
+
+    // [node * LandmarkCount() + i] is d(L_i, node) in *_from and d(node, L_i) in *_to, all ones when unreachable
+    std::vector<uint16_t> near_from;
+    std::vector<uint16_t> near_to;
+    std::vector<uint32_t> far_from;
+    std::vector<uint32_t> far_to;
+};
+
+inline uint32_t LandmarkHeuristic::operator()(uint32_t node) const { return index->LowerBound(node, target); }
+
+}
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <assert.h>
+
+#include "CSRGraph.hpp"
+#include "BitOps.hpp"
+
+namespace cyber
+{
+
+// batched breadth first search of up to laneWords * 64 sources over the same graph (MS-BFS, Then et al.)
+// every node carries seen / visit bitsets with one lane per source, a level expands each frontier node once and
+// pushes all of its lanes to a neighbor with a word-wide and-not / or, so queries that reach a node on the same
+// level share one scan of its edges instead of repeating it per query
+// per lane depths (and optionally parents) are stored lane-major, source count * node count values each
+template<uint32_t laneWords = 1>
+class MultiSourceBFS
+{
+public:
+    static constexpr uint32_t max_sources = laneWords * 64;
+
+    // lane i searches from sources[i], sources may repeat
+    void Search(const CSRGraphView& graph, const uint32_t* sources, uint32_t sourceCount, bool trackParents = false)
+    {
+        assert(sourceCount <= max_sources);
+
+        node_count = graph.node_count;
+        source_count = sourceCount;
+        track_parents = trackParents;
+
+        const size_t n = node_count;
+        seen.assign(n * laneWords, 0);
+        visit.assign(n * laneWords, 0);
+        visit_next.assign(n * laneWords, 0);
+        depths.assign(n * sourceCount, invalid_node_id);
+        parents.assign(trackParents ? n * sourceCount : 0, invalid_node_id);
+
+        frontier.clear();
+        for (uint32_t lane = 0; lane < sourceCount; ++lane)
+        {
+            uint32_t s = sources[lane];
+            if (!AnySet(&visit[size_t(s) * laneWords]))
+                frontier.push_back(s);
+
+            SetBit(&seen[size_t(s) * laneWords], lane);
+            SetBit(&visit[size_t(s) * laneWords], lane);
+            depths[size_t(lane) * n + s] = 0;
+            if (trackParents)
+                parents[size_t(lane) * n + s] = s;
+        }
+
+        for (uint32_t depth = 1; !frontier.empty(); ++depth)
+        {
+            next_frontier.clear();
+            for (uint32_t u : frontier)
+            {
+                uint64_t* visitU = &visit[size_t(u) * laneWords];
+                for (const uint32_t* itr = graph.NeighborsBegin(u), *itrEnd = graph.NeighborsEnd(u); itr != itrEnd; ++itr)
+                {
+                    uint32_t v = *itr;
+                    uint64_t* seenV = &seen[size_t(v) * laneWords];
+                    uint64_t* nextV = &visit_next[size_t(v) * laneWords];
+                    bool wasQueued = AnySet(nextV);
+
+                    // lanes that reach v for the first time this level
+                    bool any = false;
+                    for (uint32_t w = 0; w < laneWords; ++w)
+                    {
+                        uint64_t fresh = visitU[w] & ~seenV[w];
+                        if (!fresh)
+                            continue;
+
+                        any = true;
+                        seenV[w] |= fresh;
+                        nextV[w] |= fresh;
+                        for (; fresh; fresh &= fresh - 1)
+                        {
+                            size_t lane = w * 64 + CountTrailingZeros64(fresh);
+                            depths[lane * n + v] = depth;
+                            if (track_parents)
+                                parents[lane * n + v] = u;
+                        }
+                    }
+
+                    if (any && !wasQueued)
+                        next_frontier.push_back(v);
+                }
+
+                // only frontier entries are non-zero, clearing them leaves visit all zero for reuse as visit_next
+                for (uint32_t w = 0; w < laneWords; ++w)
+                    visitU[w] = 0;
+            }
+
+            visit.swap(visit_next);
+            frontier.swap(next_frontier);
+        }
+    }
+
+    inline uint32_t SourceCount() const { return source_count; }
+
+    // hop count from the lane's source per node id, invalid_node_id if not reached
+    inline const uint32_t* Depths(uint32_t lane) const { return depths.data() + size_t(lane) * node_count; }
+
+    // parent per node id for the lane (source is its own parent), nullptr unless the search tracked parents
+    inline const uint32_t* Parents(uint32_t lane) const { return track_parents ? parents.data() + size_t(lane) * node_count : nullptr; }
+
+    // path as node ids from end to the lane's source or nullptr if not reached, needs a search that tracked parents
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed(uint32_t lane, uint32_t end)
+    {
+        assert(track_parents);
+        path.clear();
+
+        const uint32_t* laneParents = Parents(lane);
+        if (laneParents[end] == invalid_node_id)
+            return nullptr;
+
+        uint32_t cur = end;
+        path.push_back(cur);
+        while (laneParents[cur] != cur)
+        {
+            cur = laneParents[cur];
+            path.push_back(cur);
+        }
+
+        return &path;
+    }
+
+private:
+    static inline bool AnySet(const uint64_t* mask)
+    {
+        uint64_t bits = 0;
+        for (uint32_t w = 0; w < laneWords; ++w)
+            bits |= mask[w];
+        return bits != 0;
+    }
+
+    uint32_t node_count = 0;
+    uint32_t source_count = 0;
+    bool track_parents = false;
+
+    // laneWords words per node
+    std::vector<uint64_t> seen;
+    std::vector<uint64_t> visit;
+    std::vector<uint64_t> visit_next;
+
+    std::vector<uint32_t> frontier;
+    std::vector<uint32_t> next_frontier;
+    std::vector<uint32_t> depths;
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> path;
+};
+
+using MultiSourceBFS64 = MultiSourceBFS<1>;
+using MultiSourceBFS256 = MultiSourceBFS<4>;
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+class ConnectivityIndex;
+
+// multi-threaded level synchronous breadth first search over a CSR graph
+// each level's frontier is cut into chunks, workers claim chunks from their own range and steal from other
+// workers' ranges when theirs runs out, nodes are claimed through an atomic visited bitmap so each is
+// discovered exactly once, per worker next frontiers are concatenated at prefix sum offsets
+// the worker threads live as long as the object, the calling thread works as worker 0
+class ParallelBFS
+{
+public:
+    static constexpr uint32_t chunk_size = 64; // frontier nodes per work item
+
+    // 0 uses all hardware threads
+    explicit ParallelBFS(uint32_t threadCount = 0);
+    ~ParallelBFS();
+    ParallelBFS(const ParallelBFS&) = delete;
+    ParallelBFS& operator=(const ParallelBFS&) = delete;
+
+    // frontiers smaller than this are expanded on the calling thread only
+    uint32_t serial_threshold = 1024;
+
+    // full traversal from source, fills Parents() and Depths()
+    void Search(const CSRGraphView& graph, uint32_t source);
+
+    // stops after the level that reaches end, returns path as node ids from end to start or nullptr if no path found
+    // path is only valid until called again
+    const std::vector<uint32_t>* FindPathReversed(const CSRGraphView& graph, uint32_t start, uint32_t end);
+
+    // optional, queries the index rejects return nullptr without searching (Parents / Depths keep the last
+    // search), nullptr disables
+    inline void SetConnectivityIndex(const ConnectivityIndex* index) { connectivity = index; }
+
+    // per node parent (source is its own parent) and hop count, invalid_node_id if not reached
+    // which of several same-level parents is recorded depends on thread timing
+    inline const std::vector<uint32_t>& Parents() const { return parents; }
+    inline const std::vector<uint32_t>& Depths() const { return depths; }
+
+    inline uint32_t ThreadCount() const { return thread_count; }
+
+private:
+    enum class Phase { Expand, Scatter };
+
+    struct alignas(64) Worker
+    {
+        std::vector<uint32_t> next;
+        std::atomic<uint32_t> chunk_cursor{ 0 };
+        uint32_t chunk_end = 0;
+        size_t output_offset = 0;
+    };
+
+    void Run(const CSRGraphView& graph, uint32_t source, uint32_t target);
+    void RunPhase(Phase phase, uint32_t workerIndex);
+    void Dispatch(Phase phase);
+    void WorkerLoop(uint32_t workerIndex);
+    void ExpandChunk(uint32_t chunk, std::vector<uint32_t>& next);
+
+    uint32_t thread_count;
+    std::unique_ptr<Worker[]> workers;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    uint64_t generation = 0;
+    uint32_t pending = 0;
+    uint32_t active_workers = 0;
+    Phase phase = Phase::Expand;
+    bool quit = false;
+
+    // current level
+    const CSRGraphView* graph = nullptr;
+    uint32_t depth = 0;
+
+    // nodes in discovery order, the current level is [frontier_begin, frontier_end) and the next one is scattered
+    // right behind it, after a search the whole prefix lists the nodes to reset
+    std::vector<uint32_t> queue;
+    size_t frontier_begin = 0;
+    size_t frontier_end = 0;
+    std::vector<uint32_t> parents;
+    std::vector<uint32_t> depths;
+    std::vector<uint32_t> path;
+    std::unique_ptr<std::atomic<uint64_t>[]> visited;
+    size_t visited_words = 0;
+    const ConnectivityIndex* connectivity = nullptr;
+};
+
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+// LRU cache of shortest paths keyed on (start, goal, graph version)
+// paths are kept end to start (FindPathReversed order) back to back in one arena, and every node on a cached path
+// is indexed, so a path A -> B passing through C also answers C -> B with a pointer into the same storage
+// (a suffix of a shortest path is a shortest path)
+// version is a caller maintained graph version, entries are only returned for the version they were stored at and
+// are dropped when looked up at another one, InvalidateEdges moves entries to a new version selectively
+class PathCache
+{
+public:
+    // evicts least recently used paths beyond either limit, paths longer than maxArenaNodes are not cached
+    explicit PathCache(uint32_t maxPaths = 4096, uint32_t maxArenaNodes = 1 << 20);
+
+    // returns the cached path from goal back to start or nullptr, length receives its node count
+    // the pointer is valid until the next Insert, InvalidateEdges or Clear
+    const uint32_t* Find(uint32_t start, uint32_t goal, uint32_t version, uint32_t& length);
+
+    // path runs from goal (path[0]) back to start (path[length - 1])
+    void Insert(uint32_t version, const uint32_t* path, uint32_t length);
+
+    // for edits that can only make paths longer (edge removal, cost increase): entries at version that cross one of
+    // edges in either direction are dropped and the rest move to newVersion, all other changes need a new version
+    void InvalidateEdges(const CSREdge* edges, size_t count, uint32_t version, uint32_t newVersion);
+
+    void Clear();
+
+    // serves from the cache or runs search.FindPathReversed(graph, start, goal) and caches its result
+    // returns the path from goal back to start or nullptr, valid until the next call on the cache or the search
+    template<typename Search>
+    const uint32_t* FindPathReversed(Search& search, const CSRGraphView& graph, uint32_t start, uint32_t goal, uint32_t version, uint32_t& length)
+    {
+        if (const uint32_t* cached = Find(start, goal, version, length))
+            return cached;
+
+        const std::vector<uint32_t>* path = search.FindPathReversed(graph, start, goal);
+        if (!path)
+        {
+            length = 0;
+            return nullptr;
+        }
+
+        length = uint32_t(path->size());
+        Insert(version, path->data(), length);
+        return path->data();
+    }
+
+    inline uint32_t PathCount() const { return path_count; }
+    inline uint32_t ArenaNodes() const { return arena_live; }
+
+    // lookups answered by a whole cached path, by a suffix of one, and not at all
+    inline uint64_t Hits() const { return hits; }
+    inline uint64_t SuffixHits() const { return suffix_hits; }
+    inline uint64_t Misses() const { return misses; }
+
+private:
+    static constexpr uint32_t invalid_entry = 0xFFFFFFFF;
+
+    struct Entry
+    {
+        uint32_t start;
+        uint32_t goal;
+        uint32_t version;
+        uint32_t offset; // into arena, invalid_entry when the entry is free
+        uint32_t length;
+        uint32_t prev; // LRU list, most recent first
+        uint32_t next;
+    };
+
+    // where node's path to a goal starts inside an entry
+    struct Slot
+    {
+        uint32_t entry;
+        uint32_t position;
+    };
+
+    static inline uint64_t Key(uint32_t node, uint32_t goal) { return (uint64_t(node) << 32) | goal; }
+
+    void Unlink(uint32_t e);
+    void LinkFront(uint32_t e);
+    void Erase(uint32_t e);
+    void Compact();
+
+    uint32_t max_paths;
+    uint32_t max_arena;
+
+    std::vector<uint32_t> arena;
+    std::vector<Entry> entries;
+    std::vector<uint32_t> free_entries;
+    std::unordered_map<uint64_t, Slot> slots; // Key(node, goal)
+    uint32_t lru_head = invalid_entry;
+    uint32_t lru_tail = invalid_entry;
+    uint32_t path_count = 0;
+    uint32_t arena_live = 0;
+
+    uint64_t hits = 0;
+    uint64_t suffix_hits = 0;
+    uint64_t misses = 0;
+};
+
+}
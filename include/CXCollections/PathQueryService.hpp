@@ -0,0 +1,89 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "CSRGraph.hpp"
+
+namespace cyber
+{
+
+class ConnectivityIndex;
+
+// asynchronous point-to-point BFS queries over one CSR graph, for moving path requests off the game thread
+// Submit may be called from any thread and pushes onto a lock-free stack, Tick (once per frame) closes the
+// pending requests into a batch, merges requests with the same start and end into one search and wakes the
+// worker pool, each worker owns a BreadthFirstSearch and claims searches until the batch is drained
+// results are paths from end to start like FindPathReversed, through a future (empty vector if no path) or a
+// callback run on the worker thread
+// the graph (and connectivity index) must stay unchanged while the service is alive
+class PathQueryService
+{
+public:
+    // path is nullptr if no path was found and is only valid during the call
+    typedef std::function<void(const std::vector<uint32_t>* path)> PathCallback;
+
+    // 0 uses all hardware threads but one, left for the submitting thread
+    explicit PathQueryService(const CSRGraphView& graph, uint32_t threadCount = 0);
+    ~PathQueryService(); // completes every submitted request
+    PathQueryService(const PathQueryService&) = delete;
+    PathQueryService& operator=(const PathQueryService&) = delete;
+
+    std::future<std::vector<uint32_t>> Submit(uint32_t start, uint32_t end);
+    void Submit(uint32_t start, uint32_t end, PathCallback callback);
+
+    // starts a batch with everything submitted so far and returns its request count, without waiting for it
+    // returns 0 if nothing was submitted or the previous batch is still running (its requests wait for a later tick)
+    size_t Tick();
+
+    // ticks and waits until every request submitted before the call is complete
+    void Flush();
+
+    // set while no batch is running, searches reject pairs the index rules out before exploring
+    void SetConnectivityIndex(const ConnectivityIndex* index);
+
+    inline uint32_t ThreadCount() const { return uint32_t(threads.size()); }
+
+    // searches run for the last batch after merging identical requests
+    inline size_t LastBatchSearches() const { return groups.empty() ? 0 : groups.size() - 1; }
+
+private:
+    struct Request
+    {
+        Request* next;
+        uint64_t key; // start << 32 | end
+        PathCallback callback;
+        std::promise<std::vector<uint32_t>> promise; // used when there is no callback
+    };
+
+    void Push(Request* request);
+    void WorkerLoop();
+    inline bool Idle() const { return in_batch == 0 && remaining.load(std::memory_order_acquire) == 0; }
+
+    CSRGraphView graph;
+    const ConnectivityIndex* connectivity = nullptr;
+    std::atomic<Request*> pending{ nullptr };
+
+    // current batch, requests sorted by key and groups holding the first request of each distinct key plus an end
+    std::vector<Request*> batch;
+    std::vector<uint32_t> groups;
+    std::atomic<uint32_t> cursor{ 0 };
+    std::atomic<uint32_t> remaining{ 0 };
+
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    uint64_t generation = 0;
+    uint32_t in_batch = 0; // workers that joined the current batch and have not left it
+    bool quit = false;
+};
+
+}
@@ -0,0 +1,79 @@
+// MIT License - CXCollections
+// Copyright(c) 2020 Dante Falcone (dantefalcone@gmail.com)
+
+#ifndef CX_RELOCATE_H
+#define CX_RELOCATE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <cstddef>
+#include <type_traits>
+#include <new>
+#include <utility>
+
+// opt a type into memcpy relocation, use at global scope
+// valid for types whose moved-to copy is bitwise identical and whose moved-from destructor does nothing observable
+// e.g. most types owning a heap pointer (unique_ptr-like, vectors with non-self-referencing storage)
+// NOT valid for types holding pointers into themselves (small buffer optimized strings, intrusive list heads)
+#define CX_TRIVIALLY_RELOCATABLE(...) \
+    namespace cyber { template<> struct is_trivially_relocatable<__VA_ARGS__> : std::true_type {}; }
+
+namespace cyber
+{
+    // true when moving an object to new memory and ending the old object's lifetime is equivalent to memcpy
+    // defaults to trivially copyable types, specialize with CX_TRIVIALLY_RELOCATABLE for others
+    template<typename T>
+    struct is_trivially_relocatable : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+    template<typename T>
+    constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // moves n objects from src to dst and ends the lifetime of the src objects
+    // dst is uninitialized memory, ranges may overlap (shifting elements within one buffer for insert/erase)
+    template<typename T>
+    inline void relocate(T* dst, T* src, size_t n) noexcept
+    {
+        if (n == 0 || dst == src)
+            return;
+
+        if constexpr (is_trivially_relocatable<T>::value)
+        {
+            memmove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * n);
+        }
+        else
+        {
+            static_assert(std::is_nothrow_move_constructible<T>::value, "relocate requires trivially relocatable or nothrow move constructible type");
+
+            if (dst < src)
+            {
+                // front to back so overlapped src objects are consumed before being overwritten
+                for (size_t i = 0; i < n; ++i)
+                {
+                    new(dst + i) T(std::move(src[i]));
+                    src[i].~T();
+                }
+            }
+            else
+            {
+                for (size_t i = n; i > 0; --i)
+                {
+                    new(dst + i - 1) T(std::move(src[i - 1]));
+                    src[i - 1].~T();
+                }
+            }
+        }
+    }
+
+    // destroys n objects in place, no-op for trivially destructible types
+    template<typename T>
+    inline void destroy(T* p, size_t n) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value)
+        {
+            for (size_t i = 0; i < n; ++i)
+                p[i].~T();
+        }
+    }
+}
+
+#endif // !CX_RELOCATE_H
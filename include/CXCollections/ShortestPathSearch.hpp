@@ -0,0 +1,222 @@
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <assert.h>
+
+#include "BreadthFirstSearch.hpp"
+#include "CSRGraph.hpp"
+#include "EpochArray.hpp"
+#include "IndexedHeap.hpp"
+#include "ConnectivityIndex.hpp"
+
+namespace cyber
+{
+
+// heuristic that turns A* into plain Dijkstra
+struct ZeroHeuristic
+{
+    template<typename Node>
+    inline uint32_t operator()(Node) const { return 0; }
+};
+
+// weighted shortest paths, Dijkstra or A* when given a heuristic, templated on the open set queue:
+//   IndexedDaryHeap<4> decreases keys in place, RadixHeap trades that for O(1) pushes on integer costs
+// works by id over CSR graphs (view weights, or 1 per edge if unweighted) and over BFSNode graphs (node costs)
+// a heuristic maps a node (id or BFSNode*) to a lower bound of its remaining cost to end, and must be consistent
+// (h(u) <= w(u, v) + h(v)) so that settled nodes are final and RadixHeap keys stay monotone
+// costs are 32-bit and path costs must stay below invalid_cost
+// like BreadthFirstSearch, labels are epoch stamped so re-using one object reaches zero allocations per query
+template<typename Heap = IndexedDaryHeap<4>>
+class ShortestPathSearch
+{
+public:
+    static constexpr uint32_t invalid_cost = 0xFFFFFFFF;
+
+    // returns cheapest path as node ids from end to start or nullptr if no path found
+    // path is only valid until called again
+    template<typename Heuristic = ZeroHeuristic>
+    const std::vector<uint32_t>* FindPathReversed(const CSRGraphView& graph, uint32_t start, uint32_t end, Heuristic heuristic = Heuristic())
+    {
+        id_path.clear();
+        if (connectivity && !connectivity->MayReach(start, end))
+        {
+            settled_nodes = 0;
+            path_cost = invalid_cost;
+            return nullptr;
+        }
+
+        CSRAdapter adapter{ graph };
+        if (!Run(adapter, id_labels, start, end, heuristic))
+            return nullptr;
+
+        BuildPath(id_labels, start, end, id_path);
+        return &id_path;
+    }
+
+    // BFSNode version, ids index the labels so they must be dense from 0
+    template<typename Heuristic = ZeroHeuristic>
+    const std::vector<BFSNode*>* FindPathReversed(BFSNode* pStart, BFSNode* pEnd, Heuristic heuristic = Heuristic())
+    {
+        path.clear();
+        NodeAdapter adapter;
+        if (!Run(adapter, node_labels, pStart, pEnd->id, heuristic))
+            return nullptr;
+
+        BuildPath(node_labels, pStart->id, pEnd->id, path);
+        return &path;
+    }
+
+    // optional, CSR queries the index rejects return nullptr without searching, nullptr disables
+    inline void SetConnectivityIndex(const ConnectivityIndex* index) { connectivity = index; }
+
+    // settles every node reachable from source, read the results with Cost()
+    void Search(const CSRGraphView& graph, uint32_t source)
+    {
+        ZeroHeuristic heuristic;
+        CSRAdapter adapter{ graph };
+        Run(adapter, id_labels, source, invalid_node_id, heuristic);
+    }
+
+    // cost from the last CSR search's start, invalid_cost if not reached
+    // exact for every reached node after Search, only for nodes on the path after FindPathReversed
+    inline uint32_t Cost(uint32_t id) const
+    {
+        return id < id_labels.Size() && id_labels.Has(id) ? id_labels.Get(id).cost : invalid_cost;
+    }
+
+    // cost of the last path found
+    inline uint32_t PathCost() const { return path_cost; }
+
+    // nodes taken off the open set by the last search, the work a heuristic saves
+    inline uint32_t SettledNodes() const { return settled_nodes; }
+
+private:
+    template<typename Node>
+    struct Label
+    {
+        uint32_t cost;
+        uint32_t prev; // id, start links to itself
+        Node node;
+        bool settled;
+    };
+
+    struct CSRAdapter
+    {
+        const CSRGraphView& graph;
+
+        inline size_t IdCount() const { return graph.node_count; }
+        static inline uint32_t Id(uint32_t node) { return node; }
+
+        template<typename Fn>
+        inline void ForEachEdge(uint32_t node, Fn&& fn) const
+        {
+            for (uint32_t e = graph.offsets[node], eEnd = graph.offsets[node + 1]; e != eEnd; ++e)
+                fn(graph.targets[e], graph.Weight(e));
+        }
+    };
+
+    struct NodeAdapter
+    {
+        // node count is not known up front, labels grow as ids are seen
+        inline size_t IdCount() const { return 0; }
+        static inline uint32_t Id(const BFSNode* node)
+        {
+            assert(node->id != invalid_node_id);
+            return node->id;
+        }
+
+        template<typename Fn>
+        inline void ForEachEdge(BFSNode* node, Fn&& fn) const
+        {
+            for (size_t k = 0; k < node->neighbors.size(); ++k)
+                fn(node->neighbors[k], node->costs.empty() ? 1u : node->costs[k]);
+        }
+    };
+
+    template<typename Adapter, typename Node, typename Heuristic>
+    bool Run(const Adapter& graph, EpochArray<Label<Node>>& labels, Node start, uint32_t endId, Heuristic& heuristic)
+    {
+        size_t idCount = graph.IdCount();
+        labels.NextEpoch(idCount);
+        open.reset(idCount);
+        settled_nodes = 0;
+        path_cost = invalid_cost;
+
+        uint32_t startId = Adapter::Id(start);
+        labels.Reserve(startId);
+        labels.Set(startId, Label<Node>{ 0, startId, start, false });
+        open.push(startId, heuristic(start));
+
+        while (!open.empty())
+        {
+            uint32_t id, key;
+            open.pop(id, key);
+
+            // queues without decrease key leave older copies behind
+            Label<Node>& label = labels[id];
+            if (label.settled)
+                continue;
+            label.settled = true;
+            ++settled_nodes;
+
+            if (id == endId)
+            {
+                path_cost = label.cost;
+                return true;
+            }
+
+            // copies, growing labels below moves the entry
+            const uint32_t cost = label.cost;
+            graph.ForEachEdge(label.node, [&](Node next, uint32_t weight)
+            {
+                uint32_t nextId = Adapter::Id(next);
+                uint32_t nextCost = cost + weight;
+                labels.Reserve(nextId);
+                if (labels.Has(nextId))
+                {
+                    Label<Node>& l = labels[nextId];
+                    if (l.settled || nextCost >= l.cost)
+                        return;
+                    l.cost = nextCost;
+                    l.prev = id;
+                }
+                else
+                {
+                    labels.Set(nextId, Label<Node>{ nextCost, id, next, false });
+                }
+                open.push(nextId, nextCost + heuristic(next));
+            });
+        }
+
+        return endId == invalid_node_id;
+    }
+
+    template<typename Node>
+    static void BuildPath(const EpochArray<Label<Node>>& labels, uint32_t startId, uint32_t endId, std::vector<Node>& out)
+    {
+        // return in reverse order
+        uint32_t id = endId;
+        out.push_back(labels.Get(id).node);
+        while (id != startId)
+        {
+            id = labels.Get(id).prev;
+            out.push_back(labels.Get(id).node);
+        }
+    }
+
+    Heap open;
+    EpochArray<Label<uint32_t>> id_labels;
+    EpochArray<Label<BFSNode*>> node_labels;
+    std::vector<uint32_t> id_path;
+    std::vector<BFSNode*> path;
+    uint32_t path_cost = invalid_cost;
+    uint32_t settled_nodes = 0;
+    const ConnectivityIndex* connectivity = nullptr;
+};
+
+using DijkstraSearch = ShortestPathSearch<IndexedDaryHeap<4>>;
+using RadixDijkstraSearch = ShortestPathSearch<RadixHeap>;
+
+}
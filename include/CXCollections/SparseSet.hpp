@@ -0,0 +1,276 @@
+// MIT License - CXCollections
+// Copyright(c) 2020 Dante Falcone (dantefalcone@gmail.com)
+
+#ifndef CX_SPARSESET_H
+#define CX_SPARSESET_H
+
+#include "Allocator.hpp"
+#include "Relocate.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <utility>
+#include <initializer_list>
+
+namespace cyber
+{
+    // sparse set of 32-bit ids: paged sparse array of dense indices -> dense array of ids
+    // O(1) insert / erase / contains, iteration is a linear walk of the dense id array
+    // sparse pages are allocated lazily from a pool, only id ranges that are used cost memory
+    // erase swaps the last dense element into the hole, dense order is not stable
+    template<size_t pageBits = 10>
+    class SparseIdSet
+    {
+    public:
+        static constexpr uint32_t invalid_index = 0xFFFFFFFF;
+        static constexpr size_t page_capacity = size_t(1) << pageBits;
+        static constexpr uint32_t page_mask = uint32_t(page_capacity - 1);
+
+        SparseIdSet() noexcept = default;
+        SparseIdSet(const SparseIdSet&) = delete; // pool storage is unique to each set
+        SparseIdSet& operator=(const SparseIdSet&) = delete;
+        ~SparseIdSet() noexcept { release_pages(); }
+
+        inline bool contains(uint32_t id) const noexcept
+        {
+            return index_of(id) != invalid_index;
+        }
+
+        // dense index of id or invalid_index
+        inline uint32_t index_of(uint32_t id) const noexcept
+        {
+            size_t page_i = id >> pageBits;
+            if (page_i >= pages.size() || pages[page_i] == nullptr)
+                return invalid_index;
+            return pages[page_i]->index[id & page_mask];
+        }
+
+        // returns false if id was already in the set
+        bool insert(uint32_t id)
+        {
+            uint32_t& slot = sparse_slot(id);
+            if (slot != invalid_index)
+                return false;
+
+            slot = uint32_t(dense.size());
+            dense.push_back(id);
+            return true;
+        }
+
+        // returns false if id was not in the set
+        bool erase(uint32_t id) noexcept
+        {
+            return erase_index(id) != invalid_index;
+        }
+
+        // keeps the sparse pages allocated for reuse
+        void clear() noexcept
+        {
+            for (uint32_t id : dense)
+                pages[id >> pageBits]->index[id & page_mask] = invalid_index;
+            dense.clear();
+        }
+
+        inline size_t size() const noexcept { return dense.size(); }
+        inline bool empty() const noexcept { return dense.empty(); }
+
+        // dense ids, valid until next insert / erase
+        inline const uint32_t* data() const noexcept { return dense.data(); }
+        inline const uint32_t* begin() const noexcept { return dense.data(); }
+        inline const uint32_t* end() const noexcept { return dense.data() + dense.size(); }
+
+    protected:
+        struct Page { uint32_t index[page_capacity]; };
+
+        // sparse entry for id, allocates its page if needed
+        uint32_t& sparse_slot(uint32_t id)
+        {
+            size_t page_i = id >> pageBits;
+            if (page_i >= pages.size())
+                pages.resize(page_i + 1, nullptr);
+
+            Page*& page = pages[page_i];
+            if (page == nullptr)
+            {
+                page = page_pool.allocate(1);
+                memset(page->index, 0xFF, sizeof(page->index));
+            }
+
+            return page->index[id & page_mask];
+        }
+
+        // removes id by swapping the last dense element into its slot, returns the old dense index
+        uint32_t erase_index(uint32_t id) noexcept
+        {
+            uint32_t idx = index_of(id);
+            if (idx == invalid_index)
+                return invalid_index;
+
+            uint32_t last_id = dense.back();
+            dense[idx] = last_id;
+            pages[last_id >> pageBits]->index[last_id & page_mask] = idx;
+            pages[id >> pageBits]->index[id & page_mask] = invalid_index;
+            dense.pop_back();
+            return idx;
+        }
+
+        void release_pages() noexcept
+        {
+            for (Page* page : pages)
+            {
+                if (page)
+                    page_pool.deallocate(page, 1);
+            }
+            pages.clear();
+
+            if (page_pool.data)
+            {
+                page_pool.free();
+                page_pool.data = nullptr;
+                page_pool.next = nullptr;
+            }
+        }
+
+        std::vector<uint32_t> dense;
+        std::vector<Page*> pages;
+        UniquePoolAllocator<Page> page_pool;
+    };
+
+    // sparse set with a value per id, values are stored densely in parallel with ids
+    // values grow and fill erase holes by relocation, see is_trivially_relocatable
+    template<typename T, size_t pageBits = 10>
+    class SparseSet : public SparseIdSet<pageBits>
+    {
+        using Base = SparseIdSet<pageBits>;
+
+    public:
+        using value_type = T;
+
+        SparseSet() noexcept = default;
+        ~SparseSet() noexcept
+        {
+            destroy(values, this->dense.size());
+            if (values)
+                Allocator<T>().deallocate(values, values_capacity);
+        }
+
+        // constructs value for id, or assigns it if id is already in the set
+        template<typename... Args>
+        T& emplace(uint32_t id, Args&&... args)
+        {
+            uint32_t& slot = this->sparse_slot(id);
+            if (slot != Base::invalid_index)
+            {
+                values[slot] = T(std::forward<Args>(args)...);
+                return values[slot];
+            }
+
+            size_t n = this->dense.size();
+            if (n == values_capacity)
+                grow();
+
+            slot = uint32_t(n);
+            this->dense.push_back(id);
+            return *new(values + n) T(std::forward<Args>(args)...);
+        }
+
+        inline T& insert(uint32_t id, const T& value) { return emplace(id, value); }
+
+        // returns nullptr if id is not in the set
+        inline T* find(uint32_t id) noexcept
+        {
+            uint32_t idx = this->index_of(id);
+            return idx == Base::invalid_index ? nullptr : &values[idx];
+        }
+
+        inline const T* find(uint32_t id) const noexcept
+        {
+            uint32_t idx = this->index_of(id);
+            return idx == Base::invalid_index ? nullptr : &values[idx];
+        }
+
+        // id must be in the set
+        inline T& operator[](uint32_t id) noexcept
+        {
+            uint32_t idx = this->index_of(id);
+            assert(idx != Base::invalid_index && "id not in sparse set");
+            return values[idx];
+        }
+
+        bool erase(uint32_t id) noexcept
+        {
+            uint32_t idx = this->erase_index(id);
+            if (idx == Base::invalid_index)
+                return false;
+
+            // last value relocates into the hole, matching the dense id swap
+            size_t last = this->dense.size();
+            values[idx].~T();
+            if (idx != last)
+                relocate(values + idx, values + last, 1);
+            return true;
+        }
+
+        void clear() noexcept
+        {
+            destroy(values, this->dense.size());
+            Base::clear();
+        }
+
+        // dense values in the same order as data()
+        inline T* values_data() noexcept { return values; }
+        inline const T* values_data() const noexcept { return values; }
+
+    private:
+        using Base::insert; // values must be constructed with the id
+
+        void grow()
+        {
+            size_t capacity = values_capacity ? values_capacity * 2 : 16;
+            T* values_new = Allocator<T>().allocate(capacity);
+            relocate(values_new, values, this->dense.size());
+            if (values)
+                Allocator<T>().deallocate(values, values_capacity);
+            values = values_new;
+            values_capacity = capacity;
+        }
+
+        T* values = nullptr;
+        size_t values_capacity = 0;
+    };
+
+    // calls fn(id) for every id contained in all sets
+    // iterates the smallest set and probes the others, cost is O(min size * set count)
+    template<size_t pageBits, typename Fn>
+    void ForEachIntersection(std::initializer_list<const SparseIdSet<pageBits>*> sets, Fn&& fn)
+    {
+        if (sets.size() == 0)
+            return;
+
+        const SparseIdSet<pageBits>* smallest = *sets.begin();
+        for (const SparseIdSet<pageBits>* set : sets)
+        {
+            if (set->size() < smallest->size())
+                smallest = set;
+        }
+
+        for (uint32_t id : *smallest)
+        {
+            bool in_all = true;
+            for (const SparseIdSet<pageBits>* set : sets)
+            {
+                if (set != smallest && !set->contains(id))
+                {
+                    in_all = false;
+                    break;
+                }
+            }
+
+            if (in_all)
+                fn(id);
+        }
+    }
+}
+
+#endif // !CX_SPARSESET_H
@@ -0,0 +1,94 @@
+#include "../include/CXCollections/BidirectionalBFS.hpp"
+#include "../include/CXCollections/ConnectivityIndex.hpp"
+
+#include <algorithm>
+
+namespace cyber
+{
+
+const std::vector<uint32_t>* BidirectionalBFS::FindPathReversed(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t start, uint32_t end)
+{
+    path.clear();
+    explored_nodes = 0;
+    if (connectivity && !connectivity->MayReach(start, end))
+        return nullptr;
+
+    forward.visits.NextEpoch(graph.node_count);
+    backward.visits.NextEpoch(graph.node_count);
+    forward.frontier.assign(1, start);
+    backward.frontier.assign(1, end);
+    forward.depth = 0;
+    backward.depth = 0;
+
+    // roots link to themselves
+    forward.visits.Set(start, Visit{ start, 0 });
+    backward.visits.Set(end, Visit{ end, 0 });
+    explored_nodes = start == end ? 1 : 2;
+
+    uint32_t meet = start == end ? start : invalid_node_id;
+    while (meet == invalid_node_id && !forward.frontier.empty() && !backward.frontier.empty())
+    {
+        // a meeting found mid level may not be the shortest, so the whole level is finished before stopping
+        if (forward.frontier.size() <= backward.frontier.size())
+            ExpandLevel(graph, forward, backward, meet);
+        else
+            ExpandLevel(reverse, backward, forward, meet);
+    }
+
+    if (meet == invalid_node_id)
+        return nullptr;
+
+    // end side chain runs meet -> end, reversed it becomes the head of the output
+    for (uint32_t cur = meet; ; cur = backward.visits.Get(cur).prev)
+    {
+        path.push_back(cur);
+        if (cur == end)
+            break;
+    }
+    std::reverse(path.begin(), path.end());
+
+    for (uint32_t cur = meet; cur != start; )
+    {
+        cur = forward.visits.Get(cur).prev;
+        path.push_back(cur);
+    }
+
+    return &path;
+}
+
+void BidirectionalBFS::ExpandLevel(const CSRGraphView& adjacency, Side& side, const Side& other, uint32_t& meet)
+{
+    uint32_t best = invalid_node_id;
+    uint32_t depth = side.depth + 1;
+
+    side.next_frontier.clear();
+    for (uint32_t u : side.frontier)
+    {
+        for (const uint32_t* itr = adjacency.NeighborsBegin(u), *itrEnd = adjacency.NeighborsEnd(u); itr != itrEnd; ++itr)
+        {
+            uint32_t v = *itr;
+            if (!side.visits.TrySet(v, Visit{ u, depth }))
+                continue;
+
+            if (other.visits.Has(v))
+            {
+                uint32_t length = depth + other.visits.Get(v).depth;
+                if (length < best)
+                {
+                    best = length;
+                    meet = v;
+                }
+            }
+            else
+            {
+                ++explored_nodes;
+            }
+            side.next_frontier.push_back(v);
+        }
+    }
+
+    side.frontier.swap(side.next_frontier);
+    side.depth = depth;
+}
+
+}
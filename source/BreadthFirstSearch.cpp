@@ -1,4 +1,8 @@
-#include "..\include\CXCollections\BreadthFirstSearch.hpp"
+#include "../include/CXCollections/BreadthFirstSearch.hpp"
+#include "../include/CXCollections/ConnectivityIndex.hpp"
+#include "../include/CXCollections/DynamicGraph.hpp"
+
+#include <assert.h>
 
 namespace cyber
 {
@@ -6,44 +10,203 @@ namespace cyber
 const std::vector<BFSNode*>* BreadthFirstSearch::FindPathReversed(BFSNode* pStart, BFSNode* pEnd)
 {
     path.clear();
+    if (!SearchNodes(pStart, pEnd))
+        return nullptr;
+
+    // return first found in reverse order
+    for (BFSNode* pCurNode = pEnd; pCurNode; pCurNode = node_to_prev_node.Get(pCurNode->id))
+        path.push_back(pCurNode);
+
+    return &path;
+}
+
+uint32_t BreadthFirstSearch::FindPath(BFSNode* pStart, BFSNode* pEnd, BFSNode** out, uint32_t capacity)
+{
+    SearchNodes(pStart, pEnd);
+    return WriteLastPath(out, capacity);
+}
+
+uint32_t BreadthFirstSearch::FindPath(BFSNode* pStart, BFSNode* pEnd, uint32_t* outIds, uint32_t capacity)
+{
+    SearchNodes(pStart, pEnd);
+    return WriteLastPath(outIds, capacity);
+}
+
+bool BreadthFirstSearch::SearchNodes(BFSNode* pStart, BFSNode* pEnd)
+{
     frontier.clear();
-    node_to_prev_node.clear();
+    node_to_prev_node.NextEpoch(0);
+    last_nodes = true;
+    last_end_node = pEnd;
+    last_length = 0;
 
+    // unnumbered nodes would all share slot 0 and look visited
+    assert(pStart->id != invalid_node_id);
     frontier.push_back(pStart);
-    node_to_prev_node[pStart] = nullptr;
+    node_to_prev_node.Reserve(pStart->id);
+    node_to_prev_node.Set(pStart->id, nullptr);
 
     BFSNode* pCurNode;
-    while (!frontier.empty())
+    size_t head = 0;
+    while (head != frontier.size())
     {
-        pCurNode = frontier.front();
-        frontier.pop_front();
+        pCurNode = frontier[head++];
 
         if (pCurNode == pEnd)
         {
-            // return first found in reverse order
-            while (pCurNode)
-            {
-                path.push_back(pCurNode);
-                pCurNode = node_to_prev_node[pCurNode];
-            }
-
-            return &path;
+            for (; pCurNode; pCurNode = node_to_prev_node.Get(pCurNode->id))
+                ++last_length;
+            return true;
         }
 
         for (BFSNode* n : pCurNode->neighbors)
         {
-            auto prevItr = node_to_prev_node.find(n);
-            // if itr not yet in map, it is shortest path
-            if (prevItr == node_to_prev_node.end())
-            {
+            assert(n->id != invalid_node_id);
+            // node count is not known up front, grow as ids are seen
+            node_to_prev_node.Reserve(n->id);
+            // if not yet visited, it is shortest path - assign cur as prev to neighbor
+            if (node_to_prev_node.TrySet(n->id, pCurNode))
                 frontier.push_back(n);
-                // assign cur as prev to neighbor
-                prevItr->second = pCurNode;
-            }
         }
     }
 
-    return nullptr;
+    return false;
+}
+
+// neighbor walks shared by the id searches
+template<typename Fn>
+static inline void ForEachNeighbor(const CSRGraphView& graph, uint32_t node, Fn&& fn)
+{
+    for (const uint32_t* itr = graph.NeighborsBegin(node), *itrEnd = graph.NeighborsEnd(node); itr != itrEnd; ++itr)
+        fn(*itr);
+}
+
+template<typename Fn>
+static inline void ForEachNeighbor(const DynamicGraph& graph, uint32_t node, Fn&& fn)
+{
+    graph.ForEachEdge(node, [&](uint32_t target, uint32_t) { fn(target); });
+}
+
+const std::vector<uint32_t>* BreadthFirstSearch::FindPathReversed(const CSRGraphView& graph, uint32_t start, uint32_t end)
+{
+    if (connectivity && !connectivity->MayReach(start, end))
+    {
+        id_path.clear();
+        last_nodes = false;
+        last_length = 0;
+        return nullptr;
+    }
+
+    return FindIdPathReversed(graph, graph.node_count, start, end);
+}
+
+const std::vector<uint32_t>* BreadthFirstSearch::FindPathReversed(const DynamicGraph& graph, uint32_t start, uint32_t end)
+{
+    return FindIdPathReversed(graph, graph.NodeCount(), start, end);
+}
+
+uint32_t BreadthFirstSearch::FindPath(const CSRGraphView& graph, uint32_t start, uint32_t end, uint32_t* out, uint32_t capacity)
+{
+    last_nodes = false;
+    last_length = 0;
+    if (!connectivity || connectivity->MayReach(start, end))
+        SearchIds(graph, graph.node_count, start, end);
+    return WriteLastPath(out, capacity);
+}
+
+uint32_t BreadthFirstSearch::FindPath(const DynamicGraph& graph, uint32_t start, uint32_t end, uint32_t* out, uint32_t capacity)
+{
+    SearchIds(graph, graph.NodeCount(), start, end);
+    return WriteLastPath(out, capacity);
+}
+
+// prev links run from end to start, filling the buffer back to front puts the path in forward order
+uint32_t BreadthFirstSearch::WriteLastPath(BFSNode** out, uint32_t capacity) const
+{
+    assert(last_nodes || last_length == 0);
+    if (last_length == 0 || last_length > capacity)
+        return last_length;
+
+    BFSNode* pCurNode = last_end_node;
+    for (uint32_t i = last_length; i-- != 0; pCurNode = node_to_prev_node.Get(pCurNode->id))
+        out[i] = pCurNode;
+    return last_length;
+}
+
+uint32_t BreadthFirstSearch::WriteLastPath(uint32_t* outIds, uint32_t capacity) const
+{
+    if (last_length == 0 || last_length > capacity)
+        return last_length;
+
+    if (last_nodes)
+    {
+        BFSNode* pCurNode = last_end_node;
+        for (uint32_t i = last_length; i-- != 0; pCurNode = node_to_prev_node.Get(pCurNode->id))
+            outIds[i] = pCurNode->id;
+    }
+    else
+    {
+        uint32_t cur = last_end;
+        for (uint32_t i = last_length; i-- != 0; cur = id_to_prev_id.Get(cur))
+            outIds[i] = cur;
+    }
+    return last_length;
+}
+
+template<typename Graph>
+const std::vector<uint32_t>* BreadthFirstSearch::FindIdPathReversed(const Graph& graph, uint32_t nodeCount, uint32_t start, uint32_t end)
+{
+    id_path.clear();
+    if (!SearchIds(graph, nodeCount, start, end))
+        return nullptr;
+
+    // return first found in reverse order
+    uint32_t cur = end;
+    id_path.push_back(cur);
+    while (cur != start)
+    {
+        cur = id_to_prev_id.Get(cur);
+        id_path.push_back(cur);
+    }
+
+    return &id_path;
+}
+
+template<typename Graph>
+bool BreadthFirstSearch::SearchIds(const Graph& graph, uint32_t nodeCount, uint32_t start, uint32_t end)
+{
+    if (id_frontier.size() < nodeCount)
+        id_frontier.resize(nodeCount);
+    id_to_prev_id.NextEpoch(nodeCount);
+    last_nodes = false;
+    last_end = end;
+    last_length = 0;
+
+    // start links to itself
+    size_t head = 0, tail = 0;
+    id_frontier[tail++] = start;
+    id_to_prev_id.Set(start, start);
+
+    while (head != tail)
+    {
+        uint32_t cur = id_frontier[head++];
+
+        if (cur == end)
+        {
+            for (last_length = 1; cur != start; ++last_length)
+                cur = id_to_prev_id.Get(cur);
+            return true;
+        }
+
+        ForEachNeighbor(graph, cur, [&](uint32_t n)
+        {
+            // if not yet visited, it is shortest path
+            if (id_to_prev_id.TrySet(n, cur))
+                id_frontier[tail++] = n;
+        });
+    }
+
+    return false;
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,155 @@
+#include "../include/CXCollections/CSRGraph.hpp"
+#include "../include/CXCollections/BreadthFirstSearch.hpp"
+#include "../include/CXCollections/GraphReordering.hpp"
+
+#include <unordered_map>
+#include <algorithm>
+#include <assert.h>
+
+namespace cyber
+{
+
+static inline uint32_t EdgeWeight(const CSREdge&) { return 1; }
+static inline uint32_t EdgeWeight(const CSRWeightedEdge& edge) { return edge.weight; }
+
+template<typename Edge>
+static void BuildCSR(CSRGraph& graph, uint32_t nodeCount, const Edge* edges, size_t edgeCount, bool undirected, bool weighted)
+{
+    size_t totalEdges = undirected ? edgeCount * 2 : edgeCount;
+    assert(totalEdges < invalid_node_id && "edge count exceeds 32-bit ids");
+
+    // counting sort by source: degrees -> exclusive prefix sum -> scatter
+    std::vector<uint32_t>& offsets = graph.offsets;
+    offsets.assign(size_t(nodeCount) + 1, 0);
+    for (size_t i = 0; i < edgeCount; ++i)
+    {
+        assert(edges[i].source < nodeCount && edges[i].target < nodeCount);
+        ++offsets[edges[i].source + 1];
+        if (undirected)
+            ++offsets[edges[i].target + 1];
+    }
+
+    for (uint32_t n = 0; n < nodeCount; ++n)
+        offsets[n + 1] += offsets[n];
+
+    graph.targets.resize(totalEdges);
+    graph.weights.resize(weighted ? totalEdges : 0);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < edgeCount; ++i)
+    {
+        uint32_t e = cursor[edges[i].source]++;
+        graph.targets[e] = edges[i].target;
+        if (weighted)
+            graph.weights[e] = EdgeWeight(edges[i]);
+
+        if (undirected)
+        {
+            e = cursor[edges[i].target]++;
+            graph.targets[e] = edges[i].source;
+            if (weighted)
+                graph.weights[e] = EdgeWeight(edges[i]);
+        }
+    }
+}
+
+void CSRGraph::BuildFromEdges(uint32_t nodeCount, const CSREdge* edges, size_t edgeCount, bool undirected)
+{
+    BuildCSR(*this, nodeCount, edges, edgeCount, undirected, false);
+}
+
+void CSRGraph::BuildFromEdges(uint32_t nodeCount, const CSRWeightedEdge* edges, size_t edgeCount, bool undirected)
+{
+    BuildCSR(*this, nodeCount, edges, edgeCount, undirected, true);
+}
+
+void CSRGraph::BuildTranspose(const CSRGraphView& graph)
+{
+    offsets.assign(size_t(graph.node_count) + 1, 0);
+    for (uint32_t e = 0; e < graph.edge_count; ++e)
+        ++offsets[graph.targets[e] + 1];
+
+    for (uint32_t n = 0; n < graph.node_count; ++n)
+        offsets[n + 1] += offsets[n];
+
+    // scanning sources in order keeps each in-edge list sorted by source
+    targets.resize(graph.edge_count);
+    weights.resize(graph.weights ? graph.edge_count : 0);
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (uint32_t n = 0; n < graph.node_count; ++n)
+    {
+        for (uint32_t e = graph.offsets[n], eEnd = graph.offsets[n + 1]; e != eEnd; ++e)
+        {
+            uint32_t r = cursor[graph.targets[e]]++;
+            targets[r] = n;
+            if (graph.weights)
+                weights[r] = graph.weights[e];
+        }
+    }
+}
+
+void CSRGraph::BuildPermuted(const CSRGraphView& graph, const NodePermutation& perm)
+{
+    assert(perm.new_to_old.size() == graph.node_count && perm.old_to_new.size() == graph.node_count);
+
+    offsets.resize(size_t(graph.node_count) + 1);
+    targets.resize(graph.edge_count);
+    weights.resize(graph.weights ? graph.edge_count : 0);
+    offsets[0] = 0;
+
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    for (uint32_t n = 0; n < graph.node_count; ++n)
+    {
+        uint32_t old = perm.new_to_old[n];
+        edges.clear();
+        for (uint32_t e = graph.offsets[old]; e != graph.offsets[old + 1]; ++e)
+            edges.push_back({ perm.old_to_new[graph.targets[e]], graph.Weight(e) });
+
+        // ascending targets turn a node's expansion into a forward sweep over search state
+        std::sort(edges.begin(), edges.end());
+        uint32_t base = offsets[n];
+        for (size_t i = 0; i < edges.size(); ++i)
+        {
+            targets[base + i] = edges[i].first;
+            if (graph.weights)
+                weights[base + i] = edges[i].second;
+        }
+        offsets[n + 1] = base + uint32_t(edges.size());
+    }
+}
+
+void CSRGraph::BuildFromNodes(BFSNode* const* nodes, size_t nodeCount)
+{
+    assert(nodeCount < invalid_node_id);
+
+    std::unordered_map<const BFSNode*, uint32_t> node_to_id;
+    node_to_id.reserve(nodeCount);
+    for (size_t i = 0; i < nodeCount; ++i)
+        node_to_id[nodes[i]] = uint32_t(i);
+
+    bool weighted = false;
+    for (size_t i = 0; i < nodeCount && !weighted; ++i)
+        weighted = !nodes[i]->costs.empty();
+
+    offsets.resize(nodeCount + 1);
+    targets.clear();
+    weights.clear();
+    offsets[0] = 0;
+    for (size_t i = 0; i < nodeCount; ++i)
+    {
+        const BFSNode* node = nodes[i];
+        assert(node->costs.empty() || node->costs.size() == node->neighbors.size());
+        for (size_t k = 0; k < node->neighbors.size(); ++k)
+        {
+            auto itr = node_to_id.find(node->neighbors[k]);
+            if (itr == node_to_id.end())
+                continue;
+
+            targets.push_back(itr->second);
+            if (weighted)
+                weights.push_back(node->costs.empty() ? 1 : node->costs[k]);
+        }
+        offsets[i + 1] = uint32_t(targets.size());
+    }
+}
+
+}
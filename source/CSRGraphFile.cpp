@@ -0,0 +1,284 @@
+#include "../include/CXCollections/CSRGraphFile.hpp"
+
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace cyber
+{
+
+static constexpr uint64_t section_alignment = 64;
+
+static inline uint64_t AlignUp(uint64_t v) { return (v + section_alignment - 1) & ~(section_alignment - 1); }
+
+// header offsets are untrusted, compare without adding them so a huge offset cannot wrap past the check
+static inline bool SectionFits(uint64_t offset, uint64_t bytes, uint64_t size)
+{
+    return offset % section_alignment == 0 && offset <= size && bytes <= size - offset;
+}
+
+// reads a whole line of any length into line, false at end of file
+static bool ReadLine(FILE* file, std::vector<char>& line)
+{
+    line.clear();
+    char chunk[256];
+    while (fgets(chunk, sizeof(chunk), file))
+    {
+        size_t length = strlen(chunk);
+        line.insert(line.end(), chunk, chunk + length);
+        if (length && chunk[length - 1] == '\n')
+            break;
+    }
+    if (line.empty())
+        return false;
+    line.push_back('\0');
+    return true;
+}
+
+// parses an unsigned decimal field below 0xFFFFFFFF, which is invalid_node_id and the searches' invalid_cost
+// strtoul would accept and negate a '-' sign, so a sign, ERANGE or a too large value make the field malformed
+// present is false and the result true when the line has no more fields
+static bool ParseField(const char*& cur, uint32_t& value, bool& present)
+{
+    while (*cur == ' ' || *cur == '\t')
+        ++cur;
+    present = false;
+    if (*cur == '-' || *cur == '+')
+        return false;
+
+    char* next;
+    errno = 0;
+    unsigned long parsed = strtoul(cur, &next, 10);
+    if (next == cur)
+        return true;
+    if (errno == ERANGE || parsed >= 0xFFFFFFFFul)
+        return false;
+
+    cur = next;
+    value = uint32_t(parsed);
+    present = true;
+    return true;
+}
+
+uint64_t CSRGraphFile::Checksum(const void* words, size_t byteCount)
+{
+    const uint64_t* w = static_cast<const uint64_t*>(words);
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0, count = byteCount / 8; i < count; ++i)
+    {
+        hash ^= w[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+bool CSRGraphFile::Open(const char* path, bool verifyChecksum)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart >= LONGLONG(sizeof(CSRFileHeader)))
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!data)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    size = size_t(fileSize.QuadPart);
+    file_handle = file;
+    mapping_handle = mapping;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(CSRFileHeader))
+    {
+        close(fd);
+        return false;
+    }
+
+    // the mapping keeps its own reference to the file
+    void* mapped = mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+        return false;
+
+    data = static_cast<const unsigned char*>(mapped);
+    size = size_t(st.st_size);
+#endif
+
+    // structural checks only touch the header and the first and last offsets
+    const CSRFileHeader& header = *reinterpret_cast<const CSRFileHeader*>(data);
+    uint64_t offsetsBytes = (uint64_t(header.node_count) + 1) * sizeof(uint32_t);
+    uint64_t edgeBytes = uint64_t(header.edge_count) * sizeof(uint32_t);
+    bool weighted = (header.flags & CSRFileHeader::flag_weighted) != 0;
+    bool valid = header.magic == CSRFileHeader::magic_value
+        && header.version == CSRFileHeader::current_version
+        && header.file_bytes == size
+        && SectionFits(header.offsets_offset, offsetsBytes, size)
+        && SectionFits(header.targets_offset, edgeBytes, size)
+        && (!weighted || SectionFits(header.weights_offset, edgeBytes, size));
+
+    if (valid)
+    {
+        const uint32_t* offsets = reinterpret_cast<const uint32_t*>(data + header.offsets_offset);
+        valid = offsets[0] == 0 && offsets[header.node_count] == header.edge_count;
+    }
+
+    if (valid && verifyChecksum)
+        valid = Checksum(data + sizeof(CSRFileHeader), size - sizeof(CSRFileHeader)) == header.checksum;
+
+    if (!valid)
+    {
+        Close();
+        return false;
+    }
+
+    view.offsets = reinterpret_cast<const uint32_t*>(data + header.offsets_offset);
+    view.targets = reinterpret_cast<const uint32_t*>(data + header.targets_offset);
+    view.weights = weighted ? reinterpret_cast<const uint32_t*>(data + header.weights_offset) : nullptr;
+    view.node_count = header.node_count;
+    view.edge_count = header.edge_count;
+    return true;
+}
+
+void CSRGraphFile::Close()
+{
+    if (data)
+    {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+        CloseHandle(mapping_handle);
+        CloseHandle(file_handle);
+        mapping_handle = nullptr;
+        file_handle = nullptr;
+#else
+        munmap(const_cast<unsigned char*>(data), size);
+#endif
+    }
+
+    data = nullptr;
+    size = 0;
+    view = CSRGraphView();
+}
+
+bool CSRGraphFile::Write(const char* path, const CSRGraphView& graph)
+{
+    static_assert(sizeof(CSRFileHeader) % 8 == 0, "header must keep the payload word aligned");
+
+    CSRFileHeader header = {};
+    header.magic = CSRFileHeader::magic_value;
+    header.version = CSRFileHeader::current_version;
+    header.node_count = graph.node_count;
+    header.edge_count = graph.edge_count;
+    header.flags = graph.weights ? CSRFileHeader::flag_weighted : 0;
+
+    uint64_t offsetsBytes = (uint64_t(graph.node_count) + 1) * sizeof(uint32_t);
+    uint64_t edgeBytes = uint64_t(graph.edge_count) * sizeof(uint32_t);
+    header.offsets_offset = AlignUp(sizeof(CSRFileHeader));
+    header.targets_offset = AlignUp(header.offsets_offset + offsetsBytes);
+    uint64_t end = header.targets_offset + edgeBytes;
+    if (graph.weights)
+    {
+        header.weights_offset = AlignUp(end);
+        end = header.weights_offset + edgeBytes;
+    }
+    header.file_bytes = AlignUp(end);
+
+    // assembled in memory so the checksum is a single pass, then written at once
+    std::vector<uint64_t> payload(size_t(header.file_bytes - sizeof(CSRFileHeader)) / 8, 0);
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(payload.data()) - sizeof(CSRFileHeader);
+    memcpy(bytes + header.offsets_offset, graph.offsets, size_t(offsetsBytes));
+    if (edgeBytes)
+    {
+        memcpy(bytes + header.targets_offset, graph.targets, size_t(edgeBytes));
+        if (graph.weights)
+            memcpy(bytes + header.weights_offset, graph.weights, size_t(edgeBytes));
+    }
+    header.checksum = Checksum(payload.data(), payload.size() * 8);
+
+    FILE* file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1
+        && (payload.empty() || fwrite(payload.data(), 8, payload.size(), file) == payload.size());
+    ok = fclose(file) == 0 && ok;
+    return ok;
+}
+
+bool CSRGraphFile::ConvertEdgeList(const char* edgeListPath, const char* outPath, bool undirected)
+{
+    FILE* file = fopen(edgeListPath, "r");
+    if (!file)
+        return false;
+
+    std::vector<CSRWeightedEdge> edges;
+    uint32_t nodeCount = 0;
+    bool weighted = false;
+    bool ok = true;
+    std::vector<char> line;
+    while (ReadLine(file, line))
+    {
+        const char* cur = line.data();
+        while (*cur == ' ' || *cur == '\t')
+            ++cur;
+        if (*cur == '#' || *cur == '%' || *cur == '\n' || *cur == '\r' || *cur == '\0')
+            continue;
+
+        uint32_t source = 0, target = 0, weight = 1;
+        bool hasSource, hasTarget, hasWeight;
+        if (!ParseField(cur, source, hasSource) || !ParseField(cur, target, hasTarget) || !ParseField(cur, weight, hasWeight) ||
+            !hasSource || !hasTarget)
+        {
+            ok = false;
+            break;
+        }
+        if (hasWeight)
+            weighted = true;
+
+        edges.push_back({ source, target, weight });
+        nodeCount = source + 1 > nodeCount ? source + 1 : nodeCount;
+        nodeCount = target + 1 > nodeCount ? target + 1 : nodeCount;
+    }
+    fclose(file);
+    if (!ok)
+        return false;
+
+    CSRGraph graph;
+    graph.BuildFromEdges(nodeCount, edges.data(), edges.size(), undirected);
+    if (!weighted)
+        graph.weights.clear();
+    return Write(outPath, graph);
+}
+
+}
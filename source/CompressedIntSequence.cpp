@@ -0,0 +1,256 @@
+#include "../include/CXCollections/CompressedIntSequence.hpp"
+
+#include <string.h>
+#include <assert.h>
+
+#if !defined(CX_SSE2)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define CX_SSE2 1
+    #else
+        #define CX_SSE2 0
+    #endif
+#endif
+
+#if CX_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace cyber
+{
+
+namespace
+{
+    // block layout: value k goes to lane k % 4 at lane position k / 4, lane words are interleaved
+    // so word w of lane l is at packed[w * 4 + l] and one 128-bit load yields the same word of every lane
+    constexpr uint32_t lanes = 4;
+    constexpr uint32_t lane_values = CompressedIntSequence::block_size / lanes;
+
+    inline uint32_t bit_width(uint32_t v)
+    {
+        uint32_t bits = 0;
+        while (v) { ++bits; v >>= 1; }
+        return bits;
+    }
+
+    inline uint32_t bit_mask(uint32_t bits)
+    {
+        return bits >= 32 ? 0xFFFFFFFFu : (1u << bits) - 1u;
+    }
+
+    void pack(const uint32_t* in, uint32_t bits, uint32_t* out)
+    {
+        memset(out, 0, sizeof(uint32_t) * lanes * bits);
+        if (bits == 0)
+            return;
+
+        for (uint32_t p = 0; p < lane_values; ++p)
+        {
+            uint32_t off = p * bits;
+            uint32_t w = off >> 5, s = off & 31;
+            for (uint32_t l = 0; l < lanes; ++l)
+            {
+                uint32_t v = in[p * lanes + l];
+                out[w * lanes + l] |= v << s;
+                if (s + bits > 32)
+                    out[(w + 1) * lanes + l] |= v >> (32 - s);
+            }
+        }
+    }
+
+    inline uint32_t unpack_one(const uint32_t* in, uint32_t bits, uint32_t k)
+    {
+        if (bits == 0)
+            return 0;
+
+        uint32_t l = k % lanes, p = k / lanes;
+        uint32_t off = p * bits;
+        uint32_t w = off >> 5, s = off & 31;
+        uint32_t v = in[w * lanes + l] >> s;
+        if (s + bits > 32)
+            v |= in[(w + 1) * lanes + l] << (32 - s);
+        return v & bit_mask(bits);
+    }
+
+    // unpacks all 128 values adding base (frame of reference) or prefix summing from base (delta)
+    void unpack(const uint32_t* in, uint32_t bits, uint32_t base, bool delta, uint32_t* out)
+    {
+#if CX_SSE2
+        const __m128i mask = _mm_set1_epi32(int32_t(bit_mask(bits)));
+        __m128i carry = _mm_set1_epi32(int32_t(base));
+        for (uint32_t p = 0; p < lane_values; ++p)
+        {
+            __m128i v = _mm_setzero_si128();
+            if (bits)
+            {
+                uint32_t off = p * bits;
+                uint32_t w = off >> 5, s = off & 31;
+                v = _mm_srl_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + w * lanes)), _mm_cvtsi32_si128(int32_t(s)));
+                if (s + bits > 32)
+                    v = _mm_or_si128(v, _mm_sll_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + (w + 1) * lanes)), _mm_cvtsi32_si128(int32_t(32 - s))));
+                v = _mm_and_si128(v, mask);
+            }
+
+            if (delta)
+            {
+                // inclusive prefix sum across the 4 lanes, then add running total
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+                v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+                v = _mm_add_epi32(v, carry);
+                carry = _mm_shuffle_epi32(v, 0xFF);
+            }
+            else
+            {
+                v = _mm_add_epi32(v, carry);
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + p * lanes), v);
+        }
+#else
+        uint32_t sum = base;
+        for (uint32_t k = 0; k < CompressedIntSequence::block_size; ++k)
+        {
+            uint32_t v = unpack_one(in, bits, k);
+            out[k] = delta ? (sum += v) : base + v;
+        }
+#endif
+    }
+}
+
+void CompressedIntSequence::push_back(uint32_t value)
+{
+    uint32_t tail_count = uint32_t(count % block_size);
+    assert((!is_sorted || count == 0 || value >= (*this)[count - 1]) && "sorted sequence requires non-decreasing values");
+
+    tail[tail_count] = value;
+    ++count;
+    if (tail_count + 1 == block_size)
+        flush_tail();
+}
+
+void CompressedIntSequence::assign(const uint32_t* values, size_t n)
+{
+    clear();
+    packed.reserve((n / block_size) * lanes * 8); // guess a quarter of raw size
+    skip.reserve(n / block_size + 1);
+    for (size_t i = 0; i < n; ++i)
+        push_back(values[i]);
+}
+
+void CompressedIntSequence::clear() noexcept
+{
+    packed.clear();
+    skip.clear();
+    count = 0;
+}
+
+void CompressedIntSequence::flush_tail()
+{
+    BlockHeader header;
+    uint32_t residuals[block_size];
+
+    if (is_sorted)
+    {
+        header.base = tail[0];
+        residuals[0] = 0;
+        uint32_t max_delta = 0;
+        for (uint32_t k = 1; k < block_size; ++k)
+        {
+            residuals[k] = tail[k] - tail[k - 1];
+            max_delta |= residuals[k];
+        }
+        header.bits = bit_width(max_delta);
+    }
+    else
+    {
+        uint32_t lo = tail[0], hi = tail[0];
+        for (uint32_t k = 1; k < block_size; ++k)
+        {
+            lo = tail[k] < lo ? tail[k] : lo;
+            hi = tail[k] > hi ? tail[k] : hi;
+        }
+        for (uint32_t k = 0; k < block_size; ++k)
+            residuals[k] = tail[k] - lo;
+        header.base = lo;
+        header.bits = bit_width(hi - lo);
+    }
+
+    header.offset = uint32_t(packed.size());
+    packed.resize(packed.size() + lanes * header.bits);
+    pack(residuals, header.bits, packed.data() + header.offset);
+    skip.push_back(header);
+}
+
+uint32_t CompressedIntSequence::operator[](size_t i) const noexcept
+{
+    assert(i < count);
+    size_t b = i / block_size;
+    uint32_t k = uint32_t(i % block_size);
+    if (b == skip.size())
+        return tail[k];
+
+    const BlockHeader& header = skip[b];
+    const uint32_t* data = packed.data() + header.offset;
+    if (!is_sorted)
+        return header.base + unpack_one(data, header.bits, k);
+
+    uint32_t v = header.base;
+    for (uint32_t j = 1; j <= k; ++j)
+        v += unpack_one(data, header.bits, j);
+    return v;
+}
+
+uint32_t CompressedIntSequence::decode_block(size_t b, uint32_t* out) const noexcept
+{
+    if (b == skip.size())
+    {
+        uint32_t n = uint32_t(count % block_size);
+        memcpy(out, tail, sizeof(uint32_t) * n);
+        return n;
+    }
+
+    const BlockHeader& header = skip[b];
+    unpack(packed.data() + header.offset, header.bits, header.base, is_sorted, out);
+    return block_size;
+}
+
+void CompressedIntSequence::decode(uint32_t* out) const noexcept
+{
+    for (size_t b = 0, n = block_count(); b < n; ++b)
+        out += decode_block(b, out);
+}
+
+size_t CompressedIntSequence::lower_bound(uint32_t value) const noexcept
+{
+    assert(is_sorted && "lower_bound requires a sorted sequence");
+
+    // first full block whose first value is not less than value
+    size_t lo = 0, hi = skip.size();
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (skip[mid].base < value) lo = mid + 1;
+        else hi = mid;
+    }
+
+    // the answer is in the preceding block unless all of it is less than value
+    uint32_t buffer[block_size];
+    if (lo > 0)
+    {
+        uint32_t n = decode_block(lo - 1, buffer);
+        for (uint32_t k = 0; k < n; ++k)
+            if (buffer[k] >= value)
+                return (lo - 1) * block_size + k;
+    }
+
+    if (lo < skip.size())
+        return lo * block_size;
+
+    // only the unpacked tail remains
+    size_t tail_begin = skip.size() * block_size;
+    for (size_t i = tail_begin; i < count; ++i)
+        if (tail[i - tail_begin] >= value)
+            return i;
+    return count;
+}
+
+}
@@ -0,0 +1,289 @@
+#include "../include/CXCollections/ConnectivityIndex.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace cyber
+{
+
+uint32_t ConnectivityIndex::Find(std::vector<uint32_t>& parent, uint32_t node)
+{
+    uint32_t root = FindRoot(parent, node);
+    while (parent[node] != root)
+    {
+        uint32_t next = parent[node];
+        parent[node] = root;
+        node = next;
+    }
+    return root;
+}
+
+bool ConnectivityIndex::UnionWeak(uint32_t a, uint32_t b)
+{
+    a = Find(weak_parent, a);
+    b = Find(weak_parent, b);
+    if (a == b)
+        return false;
+
+    if (weak_size[a] < weak_size[b])
+        std::swap(a, b);
+    weak_parent[b] = a;
+    weak_size[a] += weak_size[b];
+    return true;
+}
+
+void ConnectivityIndex::Build(const CSRGraphView& graph, bool undirectedGraph)
+{
+    const uint32_t n = graph.node_count;
+    undirected = undirectedGraph;
+
+    weak_parent.resize(n);
+    weak_size.assign(n, 1);
+    for (uint32_t v = 0; v < n; ++v)
+        weak_parent[v] = v;
+
+    uint32_t merges = 0;
+    for (uint32_t u = 0; u < n; ++u)
+    {
+        for (const uint32_t* itr = graph.NeighborsBegin(u), *itrEnd = graph.NeighborsEnd(u); itr != itrEnd; ++itr)
+            merges += UnionWeak(u, *itr) ? 1 : 0;
+    }
+    for (uint32_t v = 0; v < n; ++v)
+        weak_parent[v] = Find(weak_parent, v);
+
+    if (undirected)
+    {
+        component_count = n - merges;
+        scc_parent.clear();
+        scc_size.clear();
+        order.clear();
+        scc_out.clear();
+        scc_in.clear();
+        return;
+    }
+
+    BuildStrong(graph);
+}
+
+void ConnectivityIndex::BuildStrong(const CSRGraphView& graph)
+{
+    const uint32_t n = graph.node_count;
+    scc_parent.resize(n);
+    scc_size.assign(n, 0);
+    order.assign(n, 0);
+    scc_out.assign(n, std::vector<uint32_t>());
+    scc_in.assign(n, std::vector<uint32_t>());
+
+    // iterative Tarjan, an explicit (node, next edge) stack so deep graphs cannot overflow the call stack
+    std::vector<uint32_t> index(n, invalid_node_id);
+    std::vector<uint32_t> low(n);
+    std::vector<bool> onStack(n, false);
+    std::vector<std::pair<uint32_t, uint32_t>> calls;
+    std::vector<uint32_t> finished; // representatives in completion order, a reverse topological order
+    uint32_t nextIndex = 0;
+    stack.clear();
+
+    auto open = [&](uint32_t v)
+    {
+        index[v] = low[v] = nextIndex++;
+        stack.push_back(v);
+        onStack[v] = true;
+        calls.push_back({ v, graph.offsets[v] });
+    };
+
+    for (uint32_t s = 0; s < n; ++s)
+    {
+        if (index[s] != invalid_node_id)
+            continue;
+
+        open(s);
+        while (!calls.empty())
+        {
+            uint32_t u = calls.back().first;
+            if (calls.back().second != graph.offsets[u + 1])
+            {
+                uint32_t v = graph.targets[calls.back().second++];
+                if (index[v] == invalid_node_id)
+                    open(v);
+                else if (onStack[v])
+                    low[u] = std::min(low[u], index[v]);
+                continue;
+            }
+
+            calls.pop_back();
+            if (!calls.empty())
+                low[calls.back().first] = std::min(low[calls.back().first], low[u]);
+
+            if (low[u] == index[u])
+            {
+                uint32_t w;
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = false;
+                    scc_parent[w] = u;
+                    ++scc_size[u];
+                } while (w != u);
+                finished.push_back(u);
+            }
+        }
+    }
+
+    component_count = uint32_t(finished.size());
+    for (uint32_t i = 0; i < component_count; ++i)
+        order[finished[i]] = component_count - 1 - i;
+
+    for (uint32_t u = 0; u < n; ++u)
+    {
+        uint32_t a = scc_parent[u];
+        for (const uint32_t* itr = graph.NeighborsBegin(u), *itrEnd = graph.NeighborsEnd(u); itr != itrEnd; ++itr)
+        {
+            uint32_t b = scc_parent[*itr];
+            if (a != b)
+            {
+                scc_out[a].push_back(b);
+                scc_in[b].push_back(a);
+            }
+        }
+    }
+    for (uint32_t rep : finished)
+    {
+        std::sort(scc_out[rep].begin(), scc_out[rep].end());
+        scc_out[rep].erase(std::unique(scc_out[rep].begin(), scc_out[rep].end()), scc_out[rep].end());
+        std::sort(scc_in[rep].begin(), scc_in[rep].end());
+        scc_in[rep].erase(std::unique(scc_in[rep].begin(), scc_in[rep].end()), scc_in[rep].end());
+    }
+}
+
+void ConnectivityIndex::AddEdge(uint32_t source, uint32_t target)
+{
+    if (UnionWeak(source, target) && undirected)
+        --component_count;
+    if (undirected)
+        return;
+
+    uint32_t x = Find(scc_parent, source), y = Find(scc_parent, target);
+    if (x == y)
+        return;
+
+    scc_out[x].push_back(y);
+    scc_in[y].push_back(x);
+    if (order[x] > order[y])
+        Reorder(x, y);
+}
+
+// Pearce-Kelly repair for a new x -> y edge with y ordered before x
+// only components ordered between y and x can be affected: those reachable from y (forward) are moved after those
+// reaching x (backward), keeping their relative order and reusing their order values
+// components in both sets lie on a new cycle through x -> y and merge into one placed between the two groups
+void ConnectivityIndex::Reorder(uint32_t x, uint32_t y)
+{
+    const uint32_t lb = order[y], ub = order[x];
+    marks.NextEpoch(scc_parent.size());
+
+    auto collect = [&](uint32_t root, uint8_t bit, const std::vector<std::vector<uint32_t>>& edges, std::vector<uint32_t>& found)
+    {
+        found.clear();
+        marks.Set(root, uint8_t((marks.Has(root) ? marks.Get(root) : 0) | bit));
+        found.push_back(root);
+        stack.assign(1, root);
+        while (!stack.empty())
+        {
+            uint32_t w = stack.back();
+            stack.pop_back();
+            for (size_t i = 0; i < edges[w].size(); ++i)
+            {
+                uint32_t r = Find(scc_parent, edges[w][i]);
+                if (order[r] < lb || order[r] > ub)
+                    continue;
+
+                uint8_t mark = marks.Has(r) ? marks.Get(r) : 0;
+                if (mark & bit)
+                    continue;
+                marks.Set(r, uint8_t(mark | bit));
+                found.push_back(r);
+                stack.push_back(r);
+            }
+        }
+    };
+
+    collect(y, 1, scc_out, forward_set);
+    collect(x, 2, scc_in, backward_set);
+    bool cycle = marks.Get(x) == 3;
+
+    pool.clear();
+    for (uint32_t r : forward_set)
+        pool.push_back(order[r]);
+    for (uint32_t r : backward_set)
+    {
+        if (marks.Get(r) == 2)
+            pool.push_back(order[r]);
+    }
+    std::sort(pool.begin(), pool.end());
+
+    // split out the cycle before sorting, forward_set keeps forward only and cycle members move to the back
+    std::vector<uint32_t> members;
+    if (cycle)
+    {
+        for (uint32_t r : forward_set)
+        {
+            if (marks.Get(r) == 3)
+                members.push_back(r);
+        }
+        forward_set.erase(std::remove_if(forward_set.begin(), forward_set.end(), [&](uint32_t r) { return marks.Get(r) == 3; }), forward_set.end());
+        backward_set.erase(std::remove_if(backward_set.begin(), backward_set.end(), [&](uint32_t r) { return marks.Get(r) == 3; }), backward_set.end());
+    }
+
+    auto byOrder = [&](uint32_t a, uint32_t b) { return order[a] < order[b]; };
+    std::sort(forward_set.begin(), forward_set.end(), byOrder);
+    std::sort(backward_set.begin(), backward_set.end(), byOrder);
+
+    // backward takes the lowest values and forward the highest, so components only move away from the new edge and
+    // keep their order against the untouched ones in between, a merged cycle needs fewer values and takes the gap
+    size_t slot = 0;
+    for (uint32_t r : backward_set)
+        order[r] = pool[slot++];
+    if (cycle)
+    {
+        MergeStrong(members);
+        order[Find(scc_parent, x)] = pool[slot];
+    }
+    slot = pool.size() - forward_set.size();
+    for (uint32_t r : forward_set)
+        order[r] = pool[slot++];
+}
+
+void ConnectivityIndex::MergeStrong(const std::vector<uint32_t>& members)
+{
+    uint32_t root = members[0];
+    for (uint32_t r : members)
+        root = scc_size[r] > scc_size[root] ? r : root;
+
+    for (uint32_t r : members)
+    {
+        if (r == root)
+            continue;
+        scc_parent[r] = root;
+        scc_size[root] += scc_size[r];
+        scc_out[root].insert(scc_out[root].end(), scc_out[r].begin(), scc_out[r].end());
+        scc_in[root].insert(scc_in[root].end(), scc_in[r].begin(), scc_in[r].end());
+        std::vector<uint32_t>().swap(scc_out[r]);
+        std::vector<uint32_t>().swap(scc_in[r]);
+    }
+    component_count -= uint32_t(members.size() - 1);
+
+    // resolve to current representatives, dropping the edges that became internal
+    auto compact = [&](std::vector<uint32_t>& edges)
+    {
+        for (uint32_t& e : edges)
+            e = Find(scc_parent, e);
+        edges.erase(std::remove(edges.begin(), edges.end(), root), edges.end());
+        std::sort(edges.begin(), edges.end());
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    };
+    compact(scc_out[root]);
+    compact(scc_in[root]);
+}
+
+}
@@ -0,0 +1,181 @@
+#include "../include/CXCollections/DirectionOptimizingBFS.hpp"
+#include "../include/CXCollections/BitOps.hpp"
+#include "../include/CXCollections/ConnectivityIndex.hpp"
+
+namespace cyber
+{
+
+void DirectionOptimizingBFS::Search(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t source)
+{
+    Run(graph, reverse, source, invalid_node_id);
+}
+
+const std::vector<uint32_t>* DirectionOptimizingBFS::FindPathReversed(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t start, uint32_t end)
+{
+    path.clear();
+    if (connectivity && !connectivity->MayReach(start, end))
+        return nullptr;
+
+    Run(graph, reverse, start, end);
+
+    if (parents[end] == invalid_node_id)
+        return nullptr;
+
+    // return in reverse order
+    uint32_t cur = end;
+    path.push_back(cur);
+    while (cur != start)
+    {
+        cur = parents[cur];
+        path.push_back(cur);
+    }
+
+    return &path;
+}
+
+void DirectionOptimizingBFS::Run(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t source, uint32_t target)
+{
+    const uint32_t n = graph.node_count;
+    const size_t words = BitWords(n);
+
+    if (parents.size() == n)
+    {
+        // only nodes the last search reached are set, short queries on large graphs stay cheap
+        for (uint32_t v : touched)
+        {
+            parents[v] = invalid_node_id;
+            depths[v] = invalid_node_id;
+            visited_bits[v >> 6] = 0;
+        }
+    }
+    else
+    {
+        parents.assign(n, invalid_node_id);
+        depths.assign(n, invalid_node_id);
+        visited_bits.assign(words, 0);
+    }
+    // bottom-up clears frontier_bits when it takes over and writes every next_bits word, sizing is enough
+    frontier_bits.resize(words);
+    next_bits.resize(words);
+    if (n & 63)
+        visited_bits[words - 1] |= ~uint64_t(0) << (n & 63); // ids past the end read as visited
+
+    touched.clear();
+    touched.push_back(source);
+    frontier.clear();
+    frontier.push_back(source);
+    parents[source] = source;
+    depths[source] = 0;
+    SetBit(visited_bits.data(), source);
+
+    top_down_steps = 0;
+    bottom_up_steps = 0;
+
+    uint64_t edges_to_check = graph.edge_count;
+    uint64_t scout = graph.Degree(source);
+    uint32_t awake = 1, awake_prev = 0;
+    bool top_down = true;
+
+    for (uint32_t depth = 1; awake != 0; ++depth)
+    {
+        if (target != invalid_node_id && parents[target] != invalid_node_id)
+            break;
+
+        if (top_down && scout > edges_to_check / alpha)
+        {
+            // frontier edges outnumber what is left to explore, most top-down checks would hit visited nodes
+            for (uint64_t& w : frontier_bits) w = 0;
+            for (uint32_t u : frontier) SetBit(frontier_bits.data(), u);
+            top_down = false;
+        }
+        else if (!top_down && awake < awake_prev && awake <= n / beta)
+        {
+            // frontier is shrinking and small again
+            frontier.clear();
+            scout = 0;
+            for (size_t w = 0; w < words; ++w)
+            {
+                for (uint64_t bits = frontier_bits[w]; bits; bits &= bits - 1)
+                {
+                    uint32_t u = uint32_t(w * 64 + CountTrailingZeros64(bits));
+                    frontier.push_back(u);
+                    scout += graph.Degree(u);
+                }
+            }
+            top_down = true;
+        }
+
+        awake_prev = awake;
+        if (top_down)
+        {
+            edges_to_check = edges_to_check > scout ? edges_to_check - scout : 0;
+            scout = StepTopDown(graph, depth);
+            frontier.swap(next_frontier);
+            awake = uint32_t(frontier.size());
+            ++top_down_steps;
+        }
+        else
+        {
+            awake = StepBottomUp(reverse, depth);
+            frontier_bits.swap(next_bits);
+            ++bottom_up_steps;
+        }
+    }
+}
+
+uint64_t DirectionOptimizingBFS::StepTopDown(const CSRGraphView& graph, uint32_t depth)
+{
+    uint64_t scout = 0;
+    next_frontier.clear();
+    for (uint32_t u : frontier)
+    {
+        for (const uint32_t* itr = graph.NeighborsBegin(u), *itrEnd = graph.NeighborsEnd(u); itr != itrEnd; ++itr)
+        {
+            uint32_t v = *itr;
+            if (TestBit(visited_bits.data(), v))
+                continue;
+
+            SetBit(visited_bits.data(), v);
+            parents[v] = u;
+            depths[v] = depth;
+            next_frontier.push_back(v);
+            touched.push_back(v);
+            scout += graph.Degree(v);
+        }
+    }
+    return scout;
+}
+
+uint32_t DirectionOptimizingBFS::StepBottomUp(const CSRGraphView& reverse, uint32_t depth)
+{
+    uint32_t awake = 0;
+    for (size_t w = 0, words = visited_bits.size(); w < words; ++w)
+    {
+        uint64_t found = 0;
+        for (uint64_t unvisited = ~visited_bits[w]; unvisited; unvisited &= unvisited - 1)
+        {
+            uint32_t bit = CountTrailingZeros64(unvisited);
+            uint32_t v = uint32_t(w * 64 + bit);
+
+            // first in-neighbor in the frontier becomes the parent, remaining in edges are skipped
+            for (const uint32_t* itr = reverse.NeighborsBegin(v), *itrEnd = reverse.NeighborsEnd(v); itr != itrEnd; ++itr)
+            {
+                if (TestBit(frontier_bits.data(), *itr))
+                {
+                    parents[v] = *itr;
+                    depths[v] = depth;
+                    found |= uint64_t(1) << bit;
+                    touched.push_back(v);
+                    ++awake;
+                    break;
+                }
+            }
+        }
+
+        next_bits[w] = found;
+        visited_bits[w] |= found;
+    }
+    return awake;
+}
+
+}
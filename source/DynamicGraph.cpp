@@ -0,0 +1,198 @@
+#include "../include/CXCollections/DynamicGraph.hpp"
+
+#include <utility>
+
+namespace cyber
+{
+
+DynamicGraph::~DynamicGraph()
+{
+    JoinMerge();
+}
+
+void DynamicGraph::Reset(const CSRGraphView& graph)
+{
+    JoinMerge();
+    merged.reset();
+    merge_log.clear();
+
+    std::shared_ptr<CSRGraph> copy = std::make_shared<CSRGraph>();
+    copy->offsets.assign(graph.offsets, graph.offsets + size_t(graph.node_count) + 1);
+    copy->targets.assign(graph.targets, graph.targets + graph.edge_count);
+    if (graph.weights)
+        copy->weights.assign(graph.weights, graph.weights + graph.edge_count);
+    base = copy;
+
+    delta_head.assign(graph.node_count, invalid_node_id);
+    ClearEdits();
+    ++version;
+}
+
+void DynamicGraph::ClearEdits()
+{
+    deleted.assign(BitWords(base->EdgeCount()), 0);
+    delta_head.assign(delta_head.size(), invalid_node_id);
+    delta_tail.assign(delta_head.size(), invalid_node_id);
+    delta.clear();
+    deleted_count = 0;
+    delta_count = 0;
+    live_edges = base->EdgeCount();
+}
+
+uint32_t DynamicGraph::Degree(uint32_t node) const
+{
+    uint32_t degree = 0;
+    ForEachEdge(node, [&](uint32_t, uint32_t) { ++degree; });
+    return degree;
+}
+
+void DynamicGraph::InsertEdge(uint32_t source, uint32_t target, uint32_t weight)
+{
+    if (MergeInProgress())
+        merge_log.push_back(Edit{ source, target, weight, true });
+    Insert(source, target, weight);
+    ++version;
+}
+
+bool DynamicGraph::RemoveEdge(uint32_t source, uint32_t target)
+{
+    if (!Remove(source, target))
+        return false;
+
+    if (MergeInProgress())
+        merge_log.push_back(Edit{ source, target, 0, false });
+    ++version;
+    return true;
+}
+
+void DynamicGraph::Insert(uint32_t source, uint32_t target, uint32_t weight)
+{
+    uint32_t d = uint32_t(delta.size());
+    delta.push_back(DeltaEdge{ target, weight, invalid_node_id });
+    if (delta_tail[source] == invalid_node_id)
+        delta_head[source] = d;
+    else
+        delta[delta_tail[source]].next = d;
+    delta_tail[source] = d;
+    ++delta_count;
+    ++live_edges;
+}
+
+bool DynamicGraph::Remove(uint32_t source, uint32_t target)
+{
+    const CSRGraph& b = *base;
+    for (uint32_t e = b.offsets[source], eEnd = b.offsets[source + 1]; e != eEnd; ++e)
+    {
+        if (b.targets[e] == target && !TestBit(deleted.data(), e))
+        {
+            SetBit(deleted.data(), e);
+            ++deleted_count;
+            --live_edges;
+            return true;
+        }
+    }
+
+    for (uint32_t d = delta_head[source], prev = invalid_node_id; d != invalid_node_id; prev = d, d = delta[d].next)
+    {
+        if (delta[d].target != target)
+            continue;
+
+        if (prev == invalid_node_id)
+            delta_head[source] = delta[d].next;
+        else
+            delta[prev].next = delta[d].next;
+        if (delta_tail[source] == d)
+            delta_tail[source] = prev;
+        --delta_count;
+        --live_edges;
+        return true;
+    }
+    return false;
+}
+
+bool DynamicGraph::Maintain()
+{
+    bool installed = FinishMerge(false);
+    if (!MergeInProgress() && PendingEdits() > merge_threshold)
+        StartMerge();
+    return installed;
+}
+
+bool DynamicGraph::StartMerge()
+{
+    if (MergeInProgress())
+        return false;
+
+    // the thread works on copies of the edits, the base is shared since it never changes
+    merged = std::make_shared<CSRGraph>();
+    merge_ready.store(false, std::memory_order_relaxed);
+    merge_log.clear();
+    merge_thread = std::thread(&DynamicGraph::Merge, base, deleted, delta_head, delta, merged.get(), &merge_ready);
+    return true;
+}
+
+bool DynamicGraph::FinishMerge(bool wait)
+{
+    if (!MergeInProgress() || (!wait && !merge_ready.load(std::memory_order_acquire)))
+        return false;
+
+    merge_thread.join();
+    base = std::move(merged);
+    ClearEdits();
+
+    // edits made while merging were against the old base, replaying them gives the same neighbor lists
+    for (const Edit& edit : merge_log)
+    {
+        if (edit.insert)
+            Insert(edit.source, edit.target, edit.weight);
+        else
+            Remove(edit.source, edit.target);
+    }
+    merge_log.clear();
+    return true;
+}
+
+void DynamicGraph::JoinMerge()
+{
+    if (merge_thread.joinable())
+        merge_thread.join();
+}
+
+void DynamicGraph::Merge(std::shared_ptr<const CSRGraph> base, std::vector<uint64_t> deleted, std::vector<uint32_t> deltaHead,
+    std::vector<DeltaEdge> delta, CSRGraph* out, std::atomic<bool>* ready)
+{
+    const uint32_t n = uint32_t(deltaHead.size());
+    bool weighted = !base->weights.empty();
+    for (uint32_t v = 0; v < n && !weighted; ++v)
+    {
+        for (uint32_t d = deltaHead[v]; d != invalid_node_id && !weighted; d = delta[d].next)
+            weighted = delta[d].weight != 1;
+    }
+
+    out->offsets.resize(size_t(n) + 1);
+    out->offsets[0] = 0;
+    out->targets.clear();
+    out->weights.clear();
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        for (uint32_t e = base->offsets[v], eEnd = base->offsets[v + 1]; e != eEnd; ++e)
+        {
+            if (TestBit(deleted.data(), e))
+                continue;
+            out->targets.push_back(base->targets[e]);
+            if (weighted)
+                out->weights.push_back(base->weights.empty() ? 1 : base->weights[e]);
+        }
+        for (uint32_t d = deltaHead[v]; d != invalid_node_id; d = delta[d].next)
+        {
+            out->targets.push_back(delta[d].target);
+            if (weighted)
+                out->weights.push_back(delta[d].weight);
+        }
+        out->offsets[v + 1] = uint32_t(out->targets.size());
+    }
+
+    ready->store(true, std::memory_order_release);
+}
+
+}
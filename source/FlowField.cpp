@@ -0,0 +1,157 @@
+#include "../include/CXCollections/FlowField.hpp"
+#include "../include/CXCollections/ParallelBFS.hpp"
+#include "../include/CXCollections/IndexedHeap.hpp"
+
+#include <assert.h>
+
+namespace cyber
+{
+
+void FlowField::Build(const CSRGraphView& reverse, uint32_t goal)
+{
+    const uint32_t n = reverse.node_count;
+    goal_node = goal;
+    distances.assign(n, invalid_cost);
+    next_hops.assign(n, invalid_node_id);
+    distances[goal] = 0;
+    next_hops[goal] = goal;
+
+    if (!reverse.weights)
+    {
+        // next_hops doubles as the visited set and reduced as the queue
+        reduced.resize(n);
+        size_t head = 0, tail = 0;
+        reduced[tail++] = goal;
+        while (head != tail)
+        {
+            uint32_t u = reduced[head++];
+            for (const uint32_t* itr = reverse.NeighborsBegin(u), *itrEnd = reverse.NeighborsEnd(u); itr != itrEnd; ++itr)
+            {
+                if (next_hops[*itr] == invalid_node_id)
+                {
+                    next_hops[*itr] = u;
+                    distances[*itr] = distances[u] + 1;
+                    reduced[tail++] = *itr;
+                }
+            }
+        }
+        return;
+    }
+
+    IndexedDaryHeap<4> open;
+    open.reset(n);
+    open.push(goal, 0);
+    while (!open.empty())
+    {
+        uint32_t u, cost;
+        open.pop(u, cost);
+        for (uint32_t e = reverse.offsets[u], eEnd = reverse.offsets[u + 1]; e != eEnd; ++e)
+        {
+            uint32_t v = reverse.targets[e];
+            uint32_t nextCost = cost + reverse.weights[e];
+            if (nextCost < distances[v])
+            {
+                distances[v] = nextCost;
+                next_hops[v] = u;
+                open.push(v, nextCost);
+            }
+        }
+    }
+}
+
+void FlowField::Build(ParallelBFS& bfs, const CSRGraphView& reverse, uint32_t goal)
+{
+    assert(!reverse.weights && "parallel flow fields count hops");
+
+    // parents over the reverse graph point one step closer to the goal, unreached depths are invalid_cost too
+    bfs.Search(reverse, goal);
+    goal_node = goal;
+    distances = bfs.Depths();
+    next_hops = bfs.Parents();
+}
+
+bool FlowField::MoveGoal(const CSRGraphView& reverse, uint32_t goal)
+{
+    assert(distances.size() == reverse.node_count && "MoveGoal needs a field built over the same graph");
+
+    // the new goal must reach the old one for the old distances to be a valid potential
+    const uint32_t offset = distances[goal];
+    if (offset == invalid_cost)
+    {
+        Build(reverse, goal);
+        return false;
+    }
+
+    // reduced distance of v is new distance + old distance of the new goal - old distance of v, and the reduced cost
+    // of a step u -> v is its cost + old(u) - old(v), never negative and zero along the old field
+    const uint32_t n = reverse.node_count;
+    reduced.assign(n, invalid_cost);
+    reduced[goal] = 0;
+    next_hops[goal] = goal;
+    if (buckets.empty())
+        buckets.resize(1);
+    buckets[0].push_back(goal);
+
+    uint32_t bucketEnd = 1;
+    bool overflow = false;
+    for (uint32_t key = 0; key < bucketEnd && !overflow; ++key)
+    {
+        // zero cost steps append to the bucket being scanned
+        for (size_t i = 0; i < buckets[key].size() && !overflow; ++i)
+        {
+            uint32_t u = buckets[key][i];
+            if (reduced[u] != key)
+                continue;
+
+            const uint64_t oldU = distances[u];
+            for (uint32_t e = reverse.offsets[u], eEnd = reverse.offsets[u + 1]; e != eEnd; ++e)
+            {
+                uint32_t v = reverse.targets[e];
+                uint64_t nextKey = oldU + key + reverse.Weight(e) - distances[v];
+                if (nextKey >= reduced[v])
+                    continue;
+                if (nextKey >= max_buckets)
+                {
+                    overflow = true;
+                    break;
+                }
+
+                reduced[v] = uint32_t(nextKey);
+                next_hops[v] = u;
+                if (nextKey >= bucketEnd)
+                {
+                    bucketEnd = uint32_t(nextKey) + 1;
+                    if (buckets.size() < bucketEnd)
+                        buckets.resize(bucketEnd);
+                }
+                buckets[nextKey].push_back(v);
+            }
+        }
+        buckets[key].clear();
+    }
+
+    if (overflow)
+    {
+        for (uint32_t key = 0; key < bucketEnd; ++key)
+            buckets[key].clear();
+        Build(reverse, goal);
+        return false;
+    }
+
+    goal_node = goal;
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        if (reduced[v] == invalid_cost)
+        {
+            distances[v] = invalid_cost;
+            next_hops[v] = invalid_node_id;
+        }
+        else
+        {
+            distances[v] = reduced[v] + distances[v] - offset;
+        }
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,248 @@
+#include "../include/CXCollections/GraphReordering.hpp"
+#include "../include/CXCollections/IndexedHeap.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace cyber
+{
+
+void NodePermutation::Invert()
+{
+    old_to_new.resize(new_to_old.size());
+    for (uint32_t i = 0; i < uint32_t(new_to_old.size()); ++i)
+        old_to_new[new_to_old[i]] = i;
+}
+
+template<typename Fn>
+static inline void ForEachUndirected(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t node, Fn&& fn)
+{
+    for (const uint32_t* itr = graph.NeighborsBegin(node), *itrEnd = graph.NeighborsEnd(node); itr != itrEnd; ++itr)
+        fn(*itr);
+    for (const uint32_t* itr = reverse.NeighborsBegin(node), *itrEnd = reverse.NeighborsEnd(node); itr != itrEnd; ++itr)
+        fn(*itr);
+}
+
+void ReverseCuthillMcKeeOrder(const CSRGraphView& graph, NodePermutation& perm)
+{
+    const uint32_t n = graph.node_count;
+    CSRGraph reverseGraph;
+    reverseGraph.BuildTranspose(graph);
+    CSRGraphView reverse = reverseGraph.View();
+    auto degree = [&](uint32_t v) { return graph.Degree(v) + reverse.Degree(v); };
+    auto byDegree = [&](uint32_t a, uint32_t b) { return degree(a) < degree(b) || (degree(a) == degree(b) && a < b); };
+
+    // components start from their lowest degree node, a cheap stand-in for a pseudo-peripheral node
+    std::vector<uint32_t> starts(n);
+    for (uint32_t v = 0; v < n; ++v)
+        starts[v] = v;
+    std::stable_sort(starts.begin(), starts.end(), byDegree);
+
+    std::vector<uint32_t>& order = perm.new_to_old;
+    order.clear();
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+    for (uint32_t s : starts)
+    {
+        if (visited[s])
+            continue;
+
+        visited[s] = true;
+        order.push_back(s);
+        for (size_t head = order.size() - 1; head < order.size(); ++head)
+        {
+            size_t first = order.size();
+            ForEachUndirected(graph, reverse, order[head], [&](uint32_t v)
+            {
+                if (!visited[v])
+                {
+                    visited[v] = true;
+                    order.push_back(v);
+                }
+            });
+            std::sort(order.begin() + first, order.end(), byDegree);
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    perm.Invert();
+}
+
+void BFSOrder(const CSRGraphView& graph, uint32_t root, NodePermutation& perm)
+{
+    const uint32_t n = graph.node_count;
+    std::vector<uint32_t>& order = perm.new_to_old;
+    order.clear();
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+
+    // the order doubles as the queue
+    for (uint32_t next = 0, s = root; order.size() < n; s = next++)
+    {
+        if (visited[s])
+            continue;
+
+        visited[s] = true;
+        order.push_back(s);
+        for (size_t head = order.size() - 1; head < order.size(); ++head)
+        {
+            uint32_t u = order[head];
+            for (const uint32_t* itr = graph.NeighborsBegin(u), *itrEnd = graph.NeighborsEnd(u); itr != itrEnd; ++itr)
+            {
+                if (!visited[*itr])
+                {
+                    visited[*itr] = true;
+                    order.push_back(*itr);
+                }
+            }
+        }
+    }
+
+    perm.Invert();
+}
+
+void DFSOrder(const CSRGraphView& graph, uint32_t root, NodePermutation& perm)
+{
+    const uint32_t n = graph.node_count;
+    std::vector<uint32_t>& order = perm.new_to_old;
+    order.clear();
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+
+    // explicit stack of (node, next edge) so deep graphs cannot overflow the call stack
+    std::vector<std::pair<uint32_t, uint32_t>> stack;
+    for (uint32_t next = 0, s = root; order.size() < n; s = next++)
+    {
+        if (visited[s])
+            continue;
+
+        visited[s] = true;
+        order.push_back(s);
+        stack.push_back({ s, graph.offsets[s] });
+        while (!stack.empty())
+        {
+            std::pair<uint32_t, uint32_t>& top = stack.back();
+            if (top.second == graph.offsets[top.first + 1])
+            {
+                stack.pop_back();
+                continue;
+            }
+
+            uint32_t v = graph.targets[top.second++];
+            if (!visited[v])
+            {
+                visited[v] = true;
+                order.push_back(v);
+                stack.push_back({ v, graph.offsets[v] });
+            }
+        }
+    }
+
+    perm.Invert();
+}
+
+void DegreeSortOrder(const CSRGraphView& graph, NodePermutation& perm)
+{
+    const uint32_t n = graph.node_count;
+    uint32_t maxDegree = 0;
+    for (uint32_t v = 0; v < n; ++v)
+        maxDegree = std::max(maxDegree, graph.Degree(v));
+
+    // counting sort, bucket b holds degree maxDegree - b
+    std::vector<uint32_t> start(size_t(maxDegree) + 2, 0);
+    for (uint32_t v = 0; v < n; ++v)
+        ++start[maxDegree - graph.Degree(v) + 1];
+    for (uint32_t b = 0; b <= maxDegree; ++b)
+        start[b + 1] += start[b];
+
+    perm.new_to_old.resize(n);
+    for (uint32_t v = 0; v < n; ++v)
+        perm.new_to_old[start[maxDegree - graph.Degree(v)]++] = v;
+
+    perm.Invert();
+}
+
+void GorderLiteOrder(const CSRGraphView& graph, NodePermutation& perm, uint32_t window, uint32_t hubDegree)
+{
+    assert(window > 0);
+
+    const uint32_t n = graph.node_count;
+    CSRGraph reverseGraph;
+    reverseGraph.BuildTranspose(graph);
+    CSRGraphView reverse = reverseGraph.View();
+
+    std::vector<uint32_t> score(n, 0);
+    std::vector<bool> placed(n, false);
+
+    // min heap on inverted score, id in the low bits keeps ties deterministic
+    IndexedDaryHeap<4, uint64_t> open;
+    open.reset(n);
+    auto keyOf = [&](uint32_t v) { return (uint64_t(0xFFFFFFFF - score[v]) << 32) | v; };
+    for (uint32_t v = 0; v < n; ++v)
+        open.push(v, keyOf(v));
+
+    auto bump = [&](uint32_t u, int32_t delta)
+    {
+        if (placed[u])
+            return;
+        score[u] = uint32_t(int32_t(score[u]) + delta);
+        open.update(u, keyOf(u));
+    };
+
+    // a node entering (+1) or leaving (-1) the window adds to or removes from the score of its neighbors and of
+    // the nodes it shares a neighbor with
+    auto adjust = [&](uint32_t v, int32_t delta)
+    {
+        ForEachUndirected(graph, reverse, v, [&](uint32_t x)
+        {
+            bump(x, delta);
+            if (graph.Degree(x) + reverse.Degree(x) > hubDegree)
+                return;
+            ForEachUndirected(graph, reverse, x, [&](uint32_t u)
+            {
+                if (u != v)
+                    bump(u, delta);
+            });
+        });
+    };
+
+    std::vector<uint32_t>& order = perm.new_to_old;
+    order.clear();
+    order.reserve(n);
+    auto place = [&](uint32_t v)
+    {
+        placed[v] = true;
+        order.push_back(v);
+        adjust(v, 1);
+        if (order.size() > window)
+            adjust(order[order.size() - 1 - window], -1);
+    };
+
+    if (n == 0)
+    {
+        perm.Invert();
+        return;
+    }
+
+    // seed with the highest degree node
+    uint32_t seed = 0;
+    for (uint32_t v = 1; v < n; ++v)
+    {
+        if (graph.Degree(v) + reverse.Degree(v) > graph.Degree(seed) + reverse.Degree(seed))
+            seed = v;
+    }
+    open.erase(seed);
+    place(seed);
+
+    while (!open.empty())
+    {
+        uint32_t v;
+        uint64_t key;
+        open.pop(v, key);
+        place(v);
+    }
+
+    perm.Invert();
+}
+
+}
@@ -0,0 +1,53 @@
+#include "../include/CXCollections/GridMap.hpp"
+#include "../include/CXCollections/BitOps.hpp"
+
+#include <assert.h>
+
+namespace cyber
+{
+
+void GridMap::InitLines(std::vector<uint64_t>& lines, size_t stride, uint32_t lineLength, uint32_t lineCount)
+{
+    // one blocked word before the cells, two after so a window read at the last cell stays in the line
+    lines.assign(stride * (size_t(lineCount) + 2), ~uint64_t(0));
+    for (uint32_t line = 1; line <= lineCount; ++line)
+    {
+        uint64_t* words = lines.data() + line * stride;
+        for (uint32_t i = 0; i < lineLength; ++i)
+        {
+            uint32_t bit = i + 64;
+            words[bit >> 6] &= ~(uint64_t(1) << (bit & 63));
+        }
+    }
+}
+
+void GridMap::Resize(uint32_t w, uint32_t h)
+{
+    width = w;
+    height = h;
+    row_stride = BitWords(w) + 3;
+    column_stride = BitWords(h) + 3;
+    InitLines(rows, row_stride, w, h);
+    InitLines(columns, column_stride, h, w);
+}
+
+void GridMap::SetBlocked(uint32_t x, uint32_t y, bool blocked)
+{
+    assert(x < width && y < height);
+
+    uint64_t* row = rows.data() + size_t(y + 1) * row_stride;
+    uint64_t* column = columns.data() + size_t(x + 1) * column_stride;
+    uint32_t rowBit = x + 64, columnBit = y + 64;
+    if (blocked)
+    {
+        row[rowBit >> 6] |= uint64_t(1) << (rowBit & 63);
+        column[columnBit >> 6] |= uint64_t(1) << (columnBit & 63);
+    }
+    else
+    {
+        row[rowBit >> 6] &= ~(uint64_t(1) << (rowBit & 63));
+        column[columnBit >> 6] &= ~(uint64_t(1) << (columnBit & 63));
+    }
+}
+
+}
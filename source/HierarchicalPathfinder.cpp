@@ -0,0 +1,451 @@
+#include "../include/CXCollections/HierarchicalPathfinder.hpp"
+#include "../include/CXCollections/JumpPointSearch.hpp"
+#include "../include/CXCollections/CSRGraph.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace cyber
+{
+
+void HierarchicalPathfinder::Build(const GridMap& map, uint32_t clusterSize)
+{
+    assert(clusterSize >= 2);
+
+    grid = &map;
+    cluster_size = clusterSize;
+    clusters_x = (map.Width() + clusterSize - 1) / clusterSize;
+    clusters_y = (map.Height() + clusterSize - 1) / clusterSize;
+    // each border holds at most one transition per two cells of length plus one
+    slot_capacity = 4 * clusterSize + 4;
+
+    clusters.resize(size_t(clusters_x) * clusters_y);
+    for (uint32_t cy = 0; cy < clusters_y; ++cy)
+    {
+        for (uint32_t cx = 0; cx < clusters_x; ++cx)
+        {
+            Cluster& cluster = clusters[cy * clusters_x + cx];
+            cluster.x0 = cx * clusterSize;
+            cluster.y0 = cy * clusterSize;
+            cluster.width = std::min(clusterSize, map.Width() - cluster.x0);
+            cluster.height = std::min(clusterSize, map.Height() - cluster.y0);
+            cluster.dirty = true;
+        }
+    }
+    has_dirty = true;
+}
+
+void HierarchicalPathfinder::CellChanged(uint32_t x, uint32_t y)
+{
+    uint32_t c = ClusterOf(x, y);
+    Cluster& cluster = clusters[c];
+    cluster.dirty = true;
+    has_dirty = true;
+
+    // border cells also shape the entrances of the cluster on the other side
+    if (x == cluster.x0 && c % clusters_x != 0)
+        clusters[c - 1].dirty = true;
+    if (x == cluster.x0 + cluster.width - 1 && c % clusters_x + 1 < clusters_x)
+        clusters[c + 1].dirty = true;
+    if (y == cluster.y0 && c >= clusters_x)
+        clusters[c - clusters_x].dirty = true;
+    if (y == cluster.y0 + cluster.height - 1 && c + clusters_x < clusters.size())
+        clusters[c + clusters_x].dirty = true;
+}
+
+uint32_t HierarchicalPathfinder::AbstractNodeCount() const
+{
+    uint32_t count = 0;
+    for (const Cluster& cluster : clusters)
+        count += uint32_t(cluster.cells.size());
+    return count;
+}
+
+void HierarchicalPathfinder::BorderTransitions(uint32_t a, uint32_t b, std::vector<uint32_t>& out) const
+{
+    const Cluster& ca = clusters[a];
+    bool vertical = b == a + 1; // b is to the right, otherwise below
+    uint32_t length = vertical ? ca.height : ca.width;
+
+    auto free = [&](uint32_t i, bool other)
+    {
+        if (vertical)
+            return !grid->IsBlocked(int32_t(ca.x0 + ca.width - (other ? 0 : 1)), int32_t(ca.y0 + i));
+        return !grid->IsBlocked(int32_t(ca.x0 + i), int32_t(ca.y0 + ca.height - (other ? 0 : 1)));
+    };
+    auto emit = [&](uint32_t i)
+    {
+        uint32_t x = vertical ? ca.x0 + ca.width - 1 : ca.x0 + i;
+        uint32_t y = vertical ? ca.y0 + i : ca.y0 + ca.height - 1;
+        out.push_back(grid->CellId(x, y));
+        out.push_back(vertical ? grid->CellId(x + 1, y) : grid->CellId(x, y + 1));
+    };
+
+    // maximal runs free on both sides, short runs get a transition in the middle, long runs one at each end
+    for (uint32_t i = 0; i < length; )
+    {
+        if (!free(i, false) || !free(i, true))
+        {
+            ++i;
+            continue;
+        }
+
+        uint32_t runStart = i;
+        while (i < length && free(i, false) && free(i, true))
+            ++i;
+
+        uint32_t runLength = i - runStart;
+        if (runLength < 6)
+        {
+            emit(runStart + runLength / 2);
+        }
+        else
+        {
+            emit(runStart);
+            emit(i - 1);
+        }
+    }
+}
+
+bool HierarchicalPathfinder::CollectCells(uint32_t c)
+{
+    Cluster& cluster = clusters[c];
+    previous_cells.swap(cluster.cells);
+    cluster.cells.clear();
+
+    uint32_t cx = c % clusters_x;
+    scratch.clear();
+    if (cx + 1 < clusters_x)
+        BorderTransitions(c, c + 1, scratch);
+    if (c + clusters_x < clusters.size())
+        BorderTransitions(c, c + clusters_x, scratch);
+    for (size_t i = 0; i < scratch.size(); i += 2)
+        cluster.cells.push_back(scratch[i]);
+
+    scratch.clear();
+    if (cx > 0)
+        BorderTransitions(c - 1, c, scratch);
+    if (c >= clusters_x)
+        BorderTransitions(c - clusters_x, c, scratch);
+    for (size_t i = 0; i < scratch.size(); i += 2)
+        cluster.cells.push_back(scratch[i + 1]);
+
+    // a corner cell can be a transition on two borders
+    std::sort(cluster.cells.begin(), cluster.cells.end());
+    cluster.cells.erase(std::unique(cluster.cells.begin(), cluster.cells.end()), cluster.cells.end());
+    assert(cluster.cells.size() <= slot_capacity);
+    return cluster.cells != previous_cells;
+}
+
+void HierarchicalPathfinder::LinkInter(uint32_t c)
+{
+    Cluster& cluster = clusters[c];
+    auto localOf = [](const Cluster& owner, uint32_t cell)
+    {
+        return uint32_t(std::lower_bound(owner.cells.begin(), owner.cells.end(), cell) - owner.cells.begin());
+    };
+
+    // inter edges, neighbors' cell lists are current since dirty ones were all collected first
+    cluster.inter.clear();
+    uint32_t cx = c % clusters_x;
+    const uint32_t neighbors[4][2] = {
+        { cx + 1 < clusters_x ? c : invalid_node_id, c + 1 },
+        { c + clusters_x < clusters.size() ? c : invalid_node_id, c + clusters_x },
+        { cx > 0 ? c - 1 : invalid_node_id, c },
+        { c >= clusters_x ? c - clusters_x : invalid_node_id, c } };
+    for (const uint32_t* border : neighbors)
+    {
+        if (border[0] == invalid_node_id)
+            continue;
+
+        scratch.clear();
+        BorderTransitions(border[0], border[1], scratch);
+        bool first = border[0] == c;
+        uint32_t other = first ? border[1] : border[0];
+        for (size_t i = 0; i < scratch.size(); i += 2)
+        {
+            uint32_t mine = first ? scratch[i] : scratch[i + 1];
+            uint32_t theirs = first ? scratch[i + 1] : scratch[i];
+            cluster.inter.push_back(InterEdge{ localOf(cluster, mine), other * slot_capacity + localOf(clusters[other], theirs) });
+        }
+    }
+    std::sort(cluster.inter.begin(), cluster.inter.end(), [](const InterEdge& a, const InterEdge& b) { return a.local < b.local; });
+}
+
+void HierarchicalPathfinder::ComputeIntra(uint32_t c)
+{
+    // one local Dijkstra per transition cell
+    Cluster& cluster = clusters[c];
+    const size_t k = cluster.cells.size();
+    cluster.intra.assign(k * k, invalid_cost);
+    for (size_t i = 0; i < k; ++i)
+    {
+        LocalSearch(c, cluster.cells[i], invalid_node_id);
+        for (size_t j = 0; j < k; ++j)
+            cluster.intra[i * k + j] = LocalCost(c, cluster.cells[j]);
+    }
+}
+
+void HierarchicalPathfinder::Flush()
+{
+    rebuilt_clusters = 0;
+    if (!has_dirty)
+        return;
+    has_dirty = false;
+
+    // inter edges address the other side by local index, so a changed cell list also relinks its neighbors
+    relink.assign(clusters.size(), false);
+    for (uint32_t c = 0; c < clusters.size(); ++c)
+    {
+        if (!clusters[c].dirty)
+            continue;
+
+        relink[c] = true;
+        if (CollectCells(c))
+        {
+            uint32_t cx = c % clusters_x;
+            if (cx > 0) relink[c - 1] = true;
+            if (cx + 1 < clusters_x) relink[c + 1] = true;
+            if (c >= clusters_x) relink[c - clusters_x] = true;
+            if (c + clusters_x < clusters.size()) relink[c + clusters_x] = true;
+        }
+    }
+
+    for (uint32_t c = 0; c < clusters.size(); ++c)
+    {
+        if (relink[c])
+            LinkInter(c);
+        if (!clusters[c].dirty)
+            continue;
+        ComputeIntra(c);
+        clusters[c].dirty = false;
+        ++rebuilt_clusters;
+    }
+}
+
+bool HierarchicalPathfinder::LocalSearch(uint32_t c, uint32_t source, uint32_t target)
+{
+    const Cluster& cluster = clusters[c];
+    const int32_t x0 = int32_t(cluster.x0), y0 = int32_t(cluster.y0);
+    const int32_t w = int32_t(cluster.width), h = int32_t(cluster.height);
+    const int32_t tx = int32_t(grid->CellX(target == invalid_node_id ? source : target));
+    const int32_t ty = int32_t(grid->CellY(target == invalid_node_id ? source : target));
+    const bool toTarget = target != invalid_node_id;
+
+    local_labels.NextEpoch(size_t(cluster_size) * cluster_size);
+    local_open.reset(size_t(cluster_size) * cluster_size);
+
+    uint32_t sourceLocal = (grid->CellY(source) - cluster.y0) * cluster.width + (grid->CellX(source) - cluster.x0);
+    local_labels.Set(sourceLocal, Label{ 0, sourceLocal, false });
+    local_open.push(sourceLocal, 0);
+
+    while (!local_open.empty())
+    {
+        uint32_t cur, key;
+        local_open.pop(cur, key);
+        local_labels[cur].settled = true;
+
+        int32_t x = x0 + int32_t(cur % cluster.width), y = y0 + int32_t(cur / cluster.width);
+        if (toTarget && x == tx && y == ty)
+            return true;
+
+        uint32_t cost = local_labels.Get(cur).cost;
+        for (int32_t dy = -1; dy <= 1; ++dy)
+        {
+            for (int32_t dx = -1; dx <= 1; ++dx)
+            {
+                int32_t nx = x + dx, ny = y + dy;
+                if ((dx == 0 && dy == 0) || nx < x0 || ny < y0 || nx >= x0 + w || ny >= y0 + h || grid->IsBlocked(nx, ny))
+                    continue;
+                if (dx != 0 && dy != 0 && (grid->IsBlocked(nx, y) || grid->IsBlocked(x, ny)))
+                    continue;
+
+                uint32_t next = uint32_t((ny - y0) * w + (nx - x0));
+                uint32_t nextCost = cost + (dx != 0 && dy != 0 ? JumpPointSearch::diagonal_cost : JumpPointSearch::straight_cost);
+                if (local_labels.Has(next))
+                {
+                    Label& l = local_labels[next];
+                    if (l.settled || nextCost >= l.cost)
+                        continue;
+                    l.cost = nextCost;
+                    l.prev = cur;
+                }
+                else
+                {
+                    local_labels.Set(next, Label{ nextCost, cur, false });
+                }
+                local_open.push(next, nextCost + (toTarget ? JumpPointSearch::OctileDistance(nx, ny, tx, ty) : 0));
+            }
+        }
+    }
+
+    return false;
+}
+
+uint32_t HierarchicalPathfinder::LocalCost(uint32_t c, uint32_t cell) const
+{
+    const Cluster& cluster = clusters[c];
+    uint32_t local = (grid->CellY(cell) - cluster.y0) * cluster.width + (grid->CellX(cell) - cluster.x0);
+    return local_labels.Has(local) ? local_labels.Get(local).cost : invalid_cost;
+}
+
+uint32_t HierarchicalPathfinder::CellOf(uint32_t id) const
+{
+    uint32_t slots = uint32_t(clusters.size()) * slot_capacity;
+    if (id >= slots)
+        return id == slots ? start_cell : end_cell;
+    return clusters[id / slot_capacity].cells[id % slot_capacity];
+}
+
+void HierarchicalPathfinder::Relax(uint32_t from, uint32_t to, uint32_t cost)
+{
+    if (labels.Has(to))
+    {
+        Label& l = labels[to];
+        if (l.settled || cost >= l.cost)
+            return;
+        l.cost = cost;
+        l.prev = from;
+    }
+    else
+    {
+        labels.Set(to, Label{ cost, from, false });
+    }
+
+    uint32_t cell = CellOf(to);
+    open.push(to, cost + JumpPointSearch::OctileDistance(int32_t(grid->CellX(cell)), int32_t(grid->CellY(cell)),
+        int32_t(grid->CellX(end_cell)), int32_t(grid->CellY(end_cell))));
+}
+
+const std::vector<uint32_t>* HierarchicalPathfinder::FindPathReversed(uint32_t start, uint32_t end)
+{
+    Flush();
+
+    path.clear();
+    path_cost = invalid_cost;
+    expanded_nodes = 0;
+    if (grid->IsBlocked(int32_t(grid->CellX(start)), int32_t(grid->CellY(start))) || grid->IsBlocked(int32_t(grid->CellX(end)), int32_t(grid->CellY(end))))
+        return nullptr;
+
+    // link start and end into their clusters with one local search each
+    start_cell = start;
+    end_cell = end;
+    start_cluster = ClusterOfCell(start);
+    end_cluster = ClusterOfCell(end);
+
+    const Cluster& sc = clusters[start_cluster];
+    LocalSearch(start_cluster, start, invalid_node_id);
+    start_costs.resize(sc.cells.size());
+    for (size_t i = 0; i < sc.cells.size(); ++i)
+        start_costs[i] = LocalCost(start_cluster, sc.cells[i]);
+    direct_cost = start_cluster == end_cluster ? LocalCost(start_cluster, end) : invalid_cost;
+
+    const Cluster& ec = clusters[end_cluster];
+    LocalSearch(end_cluster, end, invalid_node_id);
+    end_costs.resize(ec.cells.size());
+    for (size_t i = 0; i < ec.cells.size(); ++i)
+        end_costs[i] = LocalCost(end_cluster, ec.cells[i]);
+
+    // abstract A*, start and end take the two ids after the cluster slots
+    const uint32_t startId = uint32_t(clusters.size()) * slot_capacity;
+    const uint32_t endId = startId + 1;
+    labels.NextEpoch(size_t(endId) + 1);
+    open.reset(size_t(endId) + 1);
+    labels.Set(startId, Label{ 0, startId, false });
+    open.push(startId, 0);
+
+    while (!open.empty())
+    {
+        uint32_t cur, key;
+        open.pop(cur, key);
+        labels[cur].settled = true;
+        ++expanded_nodes;
+
+        uint32_t cost = labels.Get(cur).cost;
+        if (cur == endId)
+        {
+            // return in reverse order, a start or end that is itself a transition cell appears once
+            path_cost = cost;
+            for (;;)
+            {
+                uint32_t cell = CellOf(cur);
+                if (path.empty() || path.back() != cell)
+                    path.push_back(cell);
+                if (cur == startId)
+                    break;
+                cur = labels.Get(cur).prev;
+            }
+            return &path;
+        }
+
+        if (cur == startId)
+        {
+            for (uint32_t i = 0; i < start_costs.size(); ++i)
+            {
+                if (start_costs[i] != invalid_cost)
+                    Relax(cur, start_cluster * slot_capacity + i, start_costs[i]);
+            }
+            if (direct_cost != invalid_cost)
+                Relax(cur, endId, direct_cost);
+            continue;
+        }
+
+        uint32_t c = cur / slot_capacity, local = cur % slot_capacity;
+        const Cluster& cluster = clusters[c];
+        const size_t k = cluster.cells.size();
+        for (uint32_t j = 0; j < k; ++j)
+        {
+            uint32_t step = cluster.intra[local * k + j];
+            if (j != local && step != invalid_cost)
+                Relax(cur, c * slot_capacity + j, cost + step);
+        }
+
+        auto inter = std::lower_bound(cluster.inter.begin(), cluster.inter.end(), local, [](const InterEdge& e, uint32_t l) { return e.local < l; });
+        for (; inter != cluster.inter.end() && inter->local == local; ++inter)
+            Relax(cur, inter->target, cost + JumpPointSearch::straight_cost);
+
+        if (c == end_cluster && end_costs[local] != invalid_cost)
+            Relax(cur, endId, cost + end_costs[local]);
+    }
+
+    return nullptr;
+}
+
+bool HierarchicalPathfinder::RefineSegment(uint32_t from, uint32_t to, std::vector<uint32_t>& cells)
+{
+    if (from == to)
+        return true;
+
+    uint32_t c = ClusterOfCell(from);
+    if (c != ClusterOfCell(to))
+    {
+        // inter edge, a single straight step across the border
+        cells.push_back(to);
+        return true;
+    }
+
+    if (!LocalSearch(c, from, to))
+        return false;
+
+    const Cluster& cluster = clusters[c];
+    uint32_t fromLocal = (grid->CellY(from) - cluster.y0) * cluster.width + (grid->CellX(from) - cluster.x0);
+    uint32_t local = (grid->CellY(to) - cluster.y0) * cluster.width + (grid->CellX(to) - cluster.x0);
+    segment.clear();
+    for (; local != fromLocal; local = local_labels.Get(local).prev)
+        segment.push_back(grid->CellId(cluster.x0 + local % cluster.width, cluster.y0 + local / cluster.width));
+    cells.insert(cells.end(), segment.rbegin(), segment.rend());
+    return true;
+}
+
+void HierarchicalPathfinder::RefinePath(const std::vector<uint32_t>& waypoints, std::vector<uint32_t>& cells)
+{
+    cells.clear();
+    if (waypoints.empty())
+        return;
+
+    cells.push_back(waypoints[0]);
+    for (size_t i = 1; i < waypoints.size(); ++i)
+        RefineSegment(waypoints[i - 1], waypoints[i], cells);
+}
+
+}
@@ -0,0 +1,235 @@
+#include "../include/CXCollections/JumpPointSearch.hpp"
+#include "../include/CXCollections/BitOps.hpp"
+#include "../include/CXCollections/CSRGraph.hpp"
+
+namespace cyber
+{
+
+// 64 cells of a padded line starting at cell pos, bit i is cell pos + dir * i
+template<int32_t dir>
+static inline uint64_t Window(const uint64_t* line, int32_t pos)
+{
+    uint32_t bit = uint32_t((dir > 0 ? pos : pos - 63) + 64);
+    uint32_t word = bit >> 6, shift = bit & 63;
+    uint64_t v = line[word] >> shift;
+    if (shift)
+        v |= line[word + 1] << (64 - shift);
+    return dir > 0 ? v : ReverseBits64(v);
+}
+
+// walks a line from pos in dir until a cell with a forced neighbor in one of the two side lines, or target
+// a side cell is forced when it is free but the side cell one step back is blocked, so it can only be reached
+// optimally through the current cell, returns the stopping position or -1 if a blocked cell comes first
+// target is a position on the line or -1 for none
+template<int32_t dir>
+static int32_t ScanLine(const uint64_t* line, const uint64_t* sideA, const uint64_t* sideB, int32_t pos, int32_t target)
+{
+    for (;;)
+    {
+        uint64_t blocked = Window<dir>(line, pos);
+        uint64_t stops = (~Window<dir>(sideA, pos) & Window<dir>(sideA, pos - dir))
+                       | (~Window<dir>(sideB, pos) & Window<dir>(sideB, pos - dir));
+
+        int32_t toTarget = (target - pos) * dir;
+        if (target >= 0 && toTarget >= 0 && toTarget < 64)
+            stops |= uint64_t(1) << toTarget;
+
+        if (blocked)
+            stops &= (uint64_t(1) << CountTrailingZeros64(blocked)) - 1;
+        if (stops)
+            return pos + dir * int32_t(CountTrailingZeros64(stops));
+        if (blocked)
+            return -1;
+
+        pos += 64 * dir;
+    }
+}
+
+uint32_t JumpPointSearch::OctileDistance(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    uint32_t dx = uint32_t(x1 > x0 ? x1 - x0 : x0 - x1);
+    uint32_t dy = uint32_t(y1 > y0 ? y1 - y0 : y0 - y1);
+    uint32_t diagonal = dx < dy ? dx : dy;
+    return diagonal * diagonal_cost + (dx + dy - 2 * diagonal) * straight_cost;
+}
+
+uint32_t JumpPointSearch::JumpStraight(int32_t x, int32_t y, int32_t dx, int32_t dy) const
+{
+    if (dy == 0)
+    {
+        int32_t target = goal_y == y ? goal_x : -1;
+        int32_t stop = dx > 0 ? ScanLine<1>(grid->Row(y), grid->Row(y - 1), grid->Row(y + 1), x + 1, target)
+                              : ScanLine<-1>(grid->Row(y), grid->Row(y - 1), grid->Row(y + 1), x - 1, target);
+        return stop < 0 ? invalid_node_id : grid->CellId(uint32_t(stop), uint32_t(y));
+    }
+    else
+    {
+        int32_t target = goal_x == x ? goal_y : -1;
+        int32_t stop = dy > 0 ? ScanLine<1>(grid->Column(x), grid->Column(x - 1), grid->Column(x + 1), y + 1, target)
+                              : ScanLine<-1>(grid->Column(x), grid->Column(x - 1), grid->Column(x + 1), y - 1, target);
+        return stop < 0 ? invalid_node_id : grid->CellId(uint32_t(x), uint32_t(stop));
+    }
+}
+
+uint32_t JumpPointSearch::Jump(int32_t x, int32_t y, int32_t dx, int32_t dy) const
+{
+    if (dx == 0 || dy == 0)
+        return JumpStraight(x, y, dx, dy);
+
+    // diagonal steps have no forced neighbors without corner cutting, a cell is a jump point when
+    // one of its straight jumps along the two components finds one
+    for (;;)
+    {
+        if (grid->IsBlocked(x + dx, y) || grid->IsBlocked(x, y + dy) || grid->IsBlocked(x + dx, y + dy))
+            return invalid_node_id;
+        x += dx;
+        y += dy;
+
+        if ((x == goal_x && y == goal_y)
+            || JumpStraight(x, y, dx, 0) != invalid_node_id
+            || JumpStraight(x, y, 0, dy) != invalid_node_id)
+            return grid->CellId(uint32_t(x), uint32_t(y));
+    }
+}
+
+void JumpPointSearch::Relax(uint32_t from, uint32_t to)
+{
+    int32_t fx = int32_t(grid->CellX(from)), fy = int32_t(grid->CellY(from));
+    int32_t tx = int32_t(grid->CellX(to)), ty = int32_t(grid->CellY(to));
+    uint32_t cost = labels.Get(from).cost + OctileDistance(fx, fy, tx, ty);
+
+    if (labels.Has(to))
+    {
+        Label& l = labels[to];
+        if (l.settled || cost >= l.cost)
+            return;
+        l.cost = cost;
+        l.prev = from;
+    }
+    else
+    {
+        labels.Set(to, Label{ cost, from, false });
+    }
+    open.push(to, cost + OctileDistance(tx, ty, goal_x, goal_y));
+}
+
+const std::vector<uint32_t>* JumpPointSearch::FindPathReversed(const GridMap& map, uint32_t start, uint32_t end)
+{
+    path.clear();
+    path_cost = 0;
+    expanded_nodes = 0;
+
+    grid = &map;
+    goal_x = int32_t(map.CellX(end));
+    goal_y = int32_t(map.CellY(end));
+    if (map.IsBlocked(int32_t(map.CellX(start)), int32_t(map.CellY(start))) || map.IsBlocked(goal_x, goal_y))
+        return nullptr;
+
+    labels.NextEpoch(map.CellCount());
+    open.reset(map.CellCount());
+    labels.Set(start, Label{ 0, start, false });
+    open.push(start, OctileDistance(int32_t(map.CellX(start)), int32_t(map.CellY(start)), goal_x, goal_y));
+
+    while (!open.empty())
+    {
+        uint32_t cur, key;
+        open.pop(cur, key);
+        labels[cur].settled = true;
+        ++expanded_nodes;
+
+        if (cur == end)
+        {
+            // return in reverse order
+            path_cost = labels.Get(cur).cost;
+            path.push_back(cur);
+            while (cur != start)
+            {
+                cur = labels.Get(cur).prev;
+                path.push_back(cur);
+            }
+            return &path;
+        }
+
+        int32_t x = int32_t(map.CellX(cur)), y = int32_t(map.CellY(cur));
+        uint32_t prev = labels.Get(cur).prev;
+        int32_t px = int32_t(map.CellX(prev)), py = int32_t(map.CellY(prev));
+        int32_t dx = x > px ? 1 : (x < px ? -1 : 0);
+        int32_t dy = y > py ? 1 : (y < py ? -1 : 0);
+
+        // pruned directions: natural neighbors of the incoming move plus forced ones
+        int32_t dirs[8][2];
+        uint32_t dirCount = 0;
+        if (dx == 0 && dy == 0)
+        {
+            static const int32_t all[8][2] = { {1,0}, {-1,0}, {0,1}, {0,-1}, {1,1}, {1,-1}, {-1,1}, {-1,-1} };
+            for (const int32_t* d : all)
+            {
+                dirs[dirCount][0] = d[0];
+                dirs[dirCount++][1] = d[1];
+            }
+        }
+        else if (dx != 0 && dy != 0)
+        {
+            dirs[dirCount][0] = dx; dirs[dirCount++][1] = 0;
+            dirs[dirCount][0] = 0;  dirs[dirCount++][1] = dy;
+            dirs[dirCount][0] = dx; dirs[dirCount++][1] = dy;
+        }
+        else if (dx != 0)
+        {
+            dirs[dirCount][0] = dx; dirs[dirCount++][1] = 0;
+            for (int32_t side = -1; side <= 1; side += 2)
+            {
+                if (!map.IsBlocked(x, y + side) && map.IsBlocked(x - dx, y + side))
+                {
+                    dirs[dirCount][0] = 0;  dirs[dirCount++][1] = side;
+                    dirs[dirCount][0] = dx; dirs[dirCount++][1] = side;
+                }
+            }
+        }
+        else
+        {
+            dirs[dirCount][0] = 0; dirs[dirCount++][1] = dy;
+            for (int32_t side = -1; side <= 1; side += 2)
+            {
+                if (!map.IsBlocked(x + side, y) && map.IsBlocked(x + side, y - dy))
+                {
+                    dirs[dirCount][0] = side; dirs[dirCount++][1] = 0;
+                    dirs[dirCount][0] = side; dirs[dirCount++][1] = dy;
+                }
+            }
+        }
+
+        for (uint32_t i = 0; i < dirCount; ++i)
+        {
+            uint32_t next = Jump(x, y, dirs[i][0], dirs[i][1]);
+            if (next != invalid_node_id)
+                Relax(cur, next);
+        }
+    }
+
+    return nullptr;
+}
+
+void JumpPointSearch::ExpandPath(const GridMap& grid, const std::vector<uint32_t>& waypoints, std::vector<uint32_t>& cells)
+{
+    cells.clear();
+    if (waypoints.empty())
+        return;
+
+    cells.push_back(waypoints[0]);
+    for (size_t i = 1; i < waypoints.size(); ++i)
+    {
+        int32_t x = int32_t(grid.CellX(waypoints[i - 1])), y = int32_t(grid.CellY(waypoints[i - 1]));
+        int32_t tx = int32_t(grid.CellX(waypoints[i])), ty = int32_t(grid.CellY(waypoints[i]));
+        int32_t dx = tx > x ? 1 : (tx < x ? -1 : 0);
+        int32_t dy = ty > y ? 1 : (ty < y ? -1 : 0);
+        while (x != tx || y != ty)
+        {
+            x += dx;
+            y += dy;
+            cells.push_back(grid.CellId(uint32_t(x), uint32_t(y)));
+        }
+    }
+}
+
+}
@@ -0,0 +1,92 @@
+#include "../include/CXCollections/LandmarkIndex.hpp"
+#include "../include/CXCollections/ShortestPathSearch.hpp"
+
+#include <algorithm>
+
+namespace cyber
+{
+
+void LandmarkIndex::Build(const CSRGraphView& graph, const CSRGraphView& reverse, uint32_t landmarkCount, uint32_t seed)
+{
+    const uint32_t n = graph.node_count;
+    const uint32_t k = std::min(landmarkCount, n);
+    const uint32_t unreachable = DijkstraSearch::invalid_cost;
+
+    landmarks.clear();
+    near_from.clear();
+    near_to.clear();
+    far_from.clear();
+    far_to.clear();
+    dead_bound = 0;
+    compact = false;
+    if (k == 0)
+        return;
+
+    DijkstraSearch dijkstra;
+    far_from.assign(size_t(n) * k, unreachable);
+    far_to.assign(size_t(n) * k, unreachable);
+
+    // round trip distance to the closest landmark, saturating so unreached nodes rank first
+    std::vector<uint64_t> score(n, ~uint64_t(0));
+
+    dijkstra.Search(graph, seed);
+    uint32_t next = seed;
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        uint32_t cost = dijkstra.Cost(v);
+        if (cost != unreachable && cost > dijkstra.Cost(next))
+            next = v;
+    }
+
+    uint32_t maxDistance = 0;
+    for (uint32_t i = 0; i < k; ++i)
+    {
+        uint32_t landmark = next;
+        landmarks.push_back(landmark);
+
+        dijkstra.Search(graph, landmark);
+        for (uint32_t v = 0; v < n; ++v)
+            far_from[size_t(v) * k + i] = dijkstra.Cost(v);
+        dijkstra.Search(reverse, landmark);
+        for (uint32_t v = 0; v < n; ++v)
+            far_to[size_t(v) * k + i] = dijkstra.Cost(v);
+
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            uint32_t from = far_from[size_t(v) * k + i], to = far_to[size_t(v) * k + i];
+            if (from != unreachable)
+                maxDistance = std::max(maxDistance, from);
+            if (to != unreachable)
+                maxDistance = std::max(maxDistance, to);
+
+            uint64_t roundTrip = from == unreachable || to == unreachable ? ~uint64_t(0) : uint64_t(from) + to;
+            score[v] = std::min(score[v], roundTrip);
+        }
+
+        next = uint32_t(std::max_element(score.begin(), score.end()) - score.begin());
+    }
+
+    dead_bound = maxDistance + 1;
+    if (maxDistance >= 0xFFFF)
+        return;
+
+    // 16-bit copies halve the bytes read per heuristic call
+    compact = true;
+    near_from.resize(far_from.size());
+    near_to.resize(far_to.size());
+    for (size_t i = 0; i < far_from.size(); ++i)
+    {
+        near_from[i] = far_from[i] == unreachable ? uint16_t(0xFFFF) : uint16_t(far_from[i]);
+        near_to[i] = far_to[i] == unreachable ? uint16_t(0xFFFF) : uint16_t(far_to[i]);
+    }
+    std::vector<uint32_t>().swap(far_from);
+    std::vector<uint32_t>().swap(far_to);
+}
+
+size_t LandmarkIndex::MemoryBytes() const
+{
+    return (near_from.size() + near_to.size()) * sizeof(uint16_t) + (far_from.size() + far_to.size()) * sizeof(uint32_t)
+        + landmarks.size() * sizeof(uint32_t);
+}
+
+}
@@ -0,0 +1,240 @@
+#include "../include/CXCollections/ParallelBFS.hpp"
+#include "../include/CXCollections/BitOps.hpp"
+#include "../include/CXCollections/ConnectivityIndex.hpp"
+
+#include <algorithm>
+
+namespace cyber
+{
+
+ParallelBFS::ParallelBFS(uint32_t threadCount)
+{
+    thread_count = threadCount ? threadCount : std::thread::hardware_concurrency();
+    if (thread_count == 0)
+        thread_count = 1;
+
+    workers.reset(new Worker[thread_count]);
+    threads.reserve(thread_count - 1);
+    for (uint32_t i = 1; i < thread_count; ++i)
+        threads.emplace_back(&ParallelBFS::WorkerLoop, this, i);
+}
+
+ParallelBFS::~ParallelBFS()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    start_cv.notify_all();
+    for (std::thread& t : threads)
+        t.join();
+}
+
+void ParallelBFS::Search(const CSRGraphView& graph, uint32_t source)
+{
+    Run(graph, source, invalid_node_id);
+}
+
+const std::vector<uint32_t>* ParallelBFS::FindPathReversed(const CSRGraphView& graph, uint32_t start, uint32_t end)
+{
+    path.clear();
+    if (connectivity && !connectivity->MayReach(start, end))
+        return nullptr;
+
+    Run(graph, start, end);
+
+    if (parents[end] == invalid_node_id)
+        return nullptr;
+
+    // return in reverse order
+    uint32_t cur = end;
+    path.push_back(cur);
+    while (cur != start)
+    {
+        cur = parents[cur];
+        path.push_back(cur);
+    }
+
+    return &path;
+}
+
+void ParallelBFS::Run(const CSRGraphView& g, uint32_t source, uint32_t target)
+{
+    const uint32_t n = g.node_count;
+    const size_t words = BitWords(n);
+
+    if (visited_words < words)
+    {
+        visited.reset(new std::atomic<uint64_t>[words]);
+        visited_words = words;
+        parents.clear(); // forces the full reset below
+    }
+
+    if (parents.size() == n)
+    {
+        // the queue holds every node the last search reached, so only those need resetting
+        for (size_t i = 0; i < frontier_end; ++i)
+        {
+            uint32_t v = queue[i];
+            parents[v] = invalid_node_id;
+            depths[v] = invalid_node_id;
+            visited[v >> 6].store(0, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        for (size_t w = 0; w < visited_words; ++w)
+            visited[w].store(0, std::memory_order_relaxed);
+        parents.assign(n, invalid_node_id);
+        depths.assign(n, invalid_node_id);
+    }
+    if (queue.size() < n)
+        queue.resize(n);
+
+    graph = &g;
+    queue[0] = source;
+    frontier_begin = 0;
+    frontier_end = 1;
+    parents[source] = source;
+    depths[source] = 0;
+    visited[source >> 6].store(uint64_t(1) << (source & 63), std::memory_order_relaxed);
+
+    for (depth = 1; frontier_begin != frontier_end; ++depth)
+    {
+        if (target != invalid_node_id && parents[target] != invalid_node_id)
+            break;
+
+        // hand each worker an even slice of chunks, small frontiers stay on this thread
+        const size_t frontierSize = frontier_end - frontier_begin;
+        uint32_t chunks = uint32_t((frontierSize + chunk_size - 1) / chunk_size);
+        active_workers = frontierSize < serial_threshold ? 1 : thread_count;
+        for (uint32_t i = 0; i < thread_count; ++i)
+        {
+            Worker& worker = workers[i];
+            uint32_t begin = i < active_workers ? uint32_t(uint64_t(chunks) * i / active_workers) : 0;
+            uint32_t end = i < active_workers ? uint32_t(uint64_t(chunks) * (i + 1) / active_workers) : 0;
+            worker.chunk_cursor.store(begin, std::memory_order_relaxed);
+            worker.chunk_end = end;
+            worker.next.clear();
+        }
+
+        if (active_workers == 1)
+            RunPhase(Phase::Expand, 0);
+        else
+            Dispatch(Phase::Expand);
+
+        // exclusive prefix sum of local frontier sizes gives each worker its output range
+        size_t total = 0;
+        for (uint32_t i = 0; i < active_workers; ++i)
+        {
+            workers[i].output_offset = total;
+            total += workers[i].next.size();
+        }
+
+        if (active_workers == 1)
+            RunPhase(Phase::Scatter, 0);
+        else
+            Dispatch(Phase::Scatter);
+
+        // the next level was scattered right behind this one, no copy
+        frontier_begin = frontier_end;
+        frontier_end += total;
+    }
+
+    graph = nullptr;
+}
+
+void ParallelBFS::Dispatch(Phase p)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        phase = p;
+        pending = thread_count - 1;
+        ++generation;
+    }
+    start_cv.notify_all();
+
+    RunPhase(p, 0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cv.wait(lock, [this] { return pending == 0; });
+}
+
+void ParallelBFS::WorkerLoop(uint32_t workerIndex)
+{
+    uint64_t seen = 0;
+    for (;;)
+    {
+        Phase p;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&] { return quit || generation != seen; });
+            if (quit)
+                return;
+            seen = generation;
+            p = phase;
+        }
+
+        RunPhase(p, workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0)
+                done_cv.notify_one();
+        }
+    }
+}
+
+void ParallelBFS::RunPhase(Phase p, uint32_t workerIndex)
+{
+    Worker& self = workers[workerIndex];
+
+    if (p == Phase::Scatter)
+    {
+        std::copy(self.next.begin(), self.next.end(), queue.begin() + frontier_end + self.output_offset);
+        return;
+    }
+
+    // own chunks first, then steal from the other active workers in ring order
+    for (uint32_t k = 0; k < active_workers; ++k)
+    {
+        Worker& victim = workers[(workerIndex + k) % active_workers];
+        for (;;)
+        {
+            uint32_t chunk = victim.chunk_cursor.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= victim.chunk_end)
+                break;
+            ExpandChunk(chunk, self.next);
+        }
+    }
+}
+
+void ParallelBFS::ExpandChunk(uint32_t chunk, std::vector<uint32_t>& next)
+{
+    size_t begin = frontier_begin + size_t(chunk) * chunk_size;
+    size_t end = begin + chunk_size < frontier_end ? begin + chunk_size : frontier_end;
+
+    for (size_t i = begin; i < end; ++i)
+    {
+        uint32_t u = queue[i];
+        for (const uint32_t* itr = graph->NeighborsBegin(u), *itrEnd = graph->NeighborsEnd(u); itr != itrEnd; ++itr)
+        {
+            uint32_t v = *itr;
+            std::atomic<uint64_t>& word = visited[v >> 6];
+            uint64_t bit = uint64_t(1) << (v & 63);
+
+            // cheap read filters most visited nodes before the atomic claim
+            if (word.load(std::memory_order_relaxed) & bit)
+                continue;
+            if (word.fetch_or(bit, std::memory_order_relaxed) & bit)
+                continue;
+
+            // claimed, only this worker writes v this level
+            parents[v] = u;
+            depths[v] = depth;
+            next.push_back(v);
+        }
+    }
+}
+
+}
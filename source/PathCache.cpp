@@ -0,0 +1,195 @@
+#include "../include/CXCollections/PathCache.hpp"
+
+#include <algorithm>
+#include <assert.h>
+
+namespace cyber
+{
+
+PathCache::PathCache(uint32_t maxPaths, uint32_t maxArenaNodes)
+    : max_paths(maxPaths)
+    , max_arena(maxArenaNodes)
+{
+    assert(maxPaths > 0);
+}
+
+const uint32_t* PathCache::Find(uint32_t start, uint32_t goal, uint32_t version, uint32_t& length)
+{
+    auto itr = slots.find(Key(start, goal));
+    if (itr == slots.end())
+    {
+        ++misses;
+        length = 0;
+        return nullptr;
+    }
+
+    Slot slot = itr->second;
+    Entry& entry = entries[slot.entry];
+    if (entry.version != version)
+    {
+        Erase(slot.entry);
+        ++misses;
+        length = 0;
+        return nullptr;
+    }
+
+    if (slot.position + 1 == entry.length)
+        ++hits;
+    else
+        ++suffix_hits;
+
+    if (lru_head != slot.entry)
+    {
+        Unlink(slot.entry);
+        LinkFront(slot.entry);
+    }
+    length = slot.position + 1;
+    return arena.data() + entry.offset;
+}
+
+void PathCache::Insert(uint32_t version, const uint32_t* path, uint32_t length)
+{
+    if (length == 0 || length > max_arena)
+        return;
+
+    uint32_t goal = path[0], start = path[length - 1];
+    auto itr = slots.find(Key(start, goal));
+    if (itr != slots.end() && entries[itr->second.entry].version == version)
+        return;
+
+    while (path_count >= max_paths || arena_live + length > max_arena)
+        Erase(lru_tail);
+    if (arena.size() + length > max_arena)
+        Compact();
+
+    uint32_t e;
+    if (free_entries.empty())
+    {
+        e = uint32_t(entries.size());
+        entries.emplace_back();
+    }
+    else
+    {
+        e = free_entries.back();
+        free_entries.pop_back();
+    }
+
+    Entry& entry = entries[e];
+    entry.start = start;
+    entry.goal = goal;
+    entry.version = version;
+    entry.offset = uint32_t(arena.size());
+    entry.length = length;
+    arena.insert(arena.end(), path, path + length);
+    LinkFront(e);
+    ++path_count;
+    arena_live += length;
+
+    // newer paths take over nodes shared with older ones
+    for (uint32_t i = 0; i < length; ++i)
+        slots[Key(path[i], goal)] = Slot{ e, i };
+}
+
+void PathCache::InvalidateEdges(const CSREdge* edges, size_t count, uint32_t version, uint32_t newVersion)
+{
+    std::vector<uint64_t> removed;
+    removed.reserve(count * 2);
+    for (size_t i = 0; i < count; ++i)
+    {
+        removed.push_back(Key(edges[i].source, edges[i].target));
+        removed.push_back(Key(edges[i].target, edges[i].source));
+    }
+    std::sort(removed.begin(), removed.end());
+
+    for (uint32_t e = lru_head; e != invalid_entry;)
+    {
+        Entry& entry = entries[e];
+        uint32_t next = entry.next;
+        if (entry.version == version)
+        {
+            const uint32_t* path = arena.data() + entry.offset;
+            bool crossed = false;
+            for (uint32_t i = 0; i + 1 < entry.length && !crossed; ++i)
+                crossed = std::binary_search(removed.begin(), removed.end(), Key(path[i + 1], path[i]));
+
+            if (crossed)
+                Erase(e);
+            else
+                entry.version = newVersion;
+        }
+        e = next;
+    }
+}
+
+void PathCache::Clear()
+{
+    arena.clear();
+    entries.clear();
+    free_entries.clear();
+    slots.clear();
+    lru_head = invalid_entry;
+    lru_tail = invalid_entry;
+    path_count = 0;
+    arena_live = 0;
+}
+
+void PathCache::Unlink(uint32_t e)
+{
+    Entry& entry = entries[e];
+    if (entry.prev != invalid_entry)
+        entries[entry.prev].next = entry.next;
+    else
+        lru_head = entry.next;
+    if (entry.next != invalid_entry)
+        entries[entry.next].prev = entry.prev;
+    else
+        lru_tail = entry.prev;
+}
+
+void PathCache::LinkFront(uint32_t e)
+{
+    Entry& entry = entries[e];
+    entry.prev = invalid_entry;
+    entry.next = lru_head;
+    if (lru_head != invalid_entry)
+        entries[lru_head].prev = e;
+    else
+        lru_tail = e;
+    lru_head = e;
+}
+
+void PathCache::Erase(uint32_t e)
+{
+    Entry& entry = entries[e];
+    const uint32_t* path = arena.data() + entry.offset;
+    for (uint32_t i = 0; i < entry.length; ++i)
+    {
+        // slots taken over by a newer path stay
+        auto itr = slots.find(Key(path[i], entry.goal));
+        if (itr != slots.end() && itr->second.entry == e)
+            slots.erase(itr);
+    }
+
+    Unlink(e);
+    --path_count;
+    arena_live -= entry.length;
+    entry.offset = invalid_entry;
+    free_entries.push_back(e);
+}
+
+// slots index positions within entries, so moving paths only rewrites entry offsets
+void PathCache::Compact()
+{
+    std::vector<uint32_t> packed;
+    packed.reserve(max_arena);
+    for (uint32_t e = lru_head; e != invalid_entry; e = entries[e].next)
+    {
+        Entry& entry = entries[e];
+        uint32_t offset = uint32_t(packed.size());
+        packed.insert(packed.end(), arena.begin() + entry.offset, arena.begin() + entry.offset + entry.length);
+        entry.offset = offset;
+    }
+    arena.swap(packed);
+}
+
+}
@@ -0,0 +1,162 @@
+#include "../include/CXCollections/PathQueryService.hpp"
+#include "../include/CXCollections/BreadthFirstSearch.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace cyber
+{
+
+PathQueryService::PathQueryService(const CSRGraphView& g, uint32_t threadCount)
+    : graph(g)
+{
+    if (threadCount == 0)
+    {
+        uint32_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 1;
+    }
+
+    threads.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; ++i)
+        threads.emplace_back(&PathQueryService::WorkerLoop, this);
+}
+
+PathQueryService::~PathQueryService()
+{
+    Flush();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    start_cv.notify_all();
+    for (std::thread& t : threads)
+        t.join();
+}
+
+void PathQueryService::Push(Request* request)
+{
+    // the consumer takes the whole stack at once, so there is no pop to suffer from ABA
+    Request* head = pending.load(std::memory_order_relaxed);
+    do
+    {
+        request->next = head;
+    } while (!pending.compare_exchange_weak(head, request, std::memory_order_release, std::memory_order_relaxed));
+}
+
+std::future<std::vector<uint32_t>> PathQueryService::Submit(uint32_t start, uint32_t end)
+{
+    Request* request = new Request();
+    request->key = (uint64_t(start) << 32) | end;
+    std::future<std::vector<uint32_t>> result = request->promise.get_future();
+    Push(request);
+    return result;
+}
+
+void PathQueryService::Submit(uint32_t start, uint32_t end, PathCallback callback)
+{
+    Request* request = new Request();
+    request->key = (uint64_t(start) << 32) | end;
+    request->callback = std::move(callback);
+    Push(request);
+}
+
+size_t PathQueryService::Tick()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!Idle())
+        return 0;
+
+    Request* list = pending.exchange(nullptr, std::memory_order_acquire);
+    if (!list)
+        return 0;
+
+    batch.clear();
+    for (; list; list = list->next)
+        batch.push_back(list);
+
+    // sorting groups duplicates and hands workers neighboring starts
+    std::sort(batch.begin(), batch.end(), [](const Request* a, const Request* b) { return a->key < b->key; });
+    groups.clear();
+    for (uint32_t i = 0; i < uint32_t(batch.size()); ++i)
+    {
+        if (i == 0 || batch[i]->key != batch[i - 1]->key)
+            groups.push_back(i);
+    }
+    groups.push_back(uint32_t(batch.size()));
+
+    cursor.store(0, std::memory_order_relaxed);
+    remaining.store(uint32_t(groups.size() - 1), std::memory_order_relaxed);
+    ++generation;
+    start_cv.notify_all();
+    return batch.size();
+}
+
+void PathQueryService::Flush()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done_cv.wait(lock, [this] { return Idle(); });
+            if (!pending.load(std::memory_order_acquire))
+                return;
+        }
+        Tick();
+    }
+}
+
+void PathQueryService::SetConnectivityIndex(const ConnectivityIndex* index)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    connectivity = index;
+}
+
+void PathQueryService::WorkerLoop()
+{
+    BreadthFirstSearch search;
+    uint64_t seen = 0;
+    for (;;)
+    {
+        // joining under the lock keeps Tick from replacing the batch while this worker still reads it
+        uint32_t groupCount;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            start_cv.wait(lock, [&] { return quit || generation != seen; });
+            if (generation == seen)
+                return;
+            seen = generation;
+            ++in_batch;
+            groupCount = uint32_t(groups.size() - 1);
+            search.SetConnectivityIndex(connectivity);
+        }
+
+        for (;;)
+        {
+            uint32_t g = cursor.fetch_add(1, std::memory_order_relaxed);
+            if (g >= groupCount)
+                break;
+
+            uint32_t first = groups[g], last = groups[g + 1];
+            uint64_t key = batch[first]->key;
+            const std::vector<uint32_t>* path = search.FindPathReversed(graph, uint32_t(key >> 32), uint32_t(key));
+            for (uint32_t i = first; i < last; ++i)
+            {
+                Request* request = batch[i];
+                if (request->callback)
+                    request->callback(path);
+                else
+                    request->promise.set_value(path ? *path : std::vector<uint32_t>());
+                delete request;
+            }
+            remaining.fetch_sub(1, std::memory_order_release);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--in_batch == 0)
+                done_cv.notify_all();
+        }
+    }
+}
+
+}
@@ -0,0 +1,572 @@
+#include "BreadthFirstSearch.hpp"
+#include "BidirectionalBFS.hpp"
+#include "DirectionOptimizingBFS.hpp"
+#include "ShortestPathSearch.hpp"
+#include "LandmarkIndex.hpp"
+#include "CSRGraph.hpp"
+#include "CSRGraphFile.hpp"
+
+#include <vector>
+#include <string>
+#include <stdint.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// graph search benchmark, CXGraphBench [-q queries] [-r roots] [--small] [graph.cxg ...]
+// without files runs the synthetic suite: 2D / 3D grids with obstacles, Kronecker (R-MAT) scale-free and
+// random geometric graphs, files are loaded through the mmap format (CSRGraphFile)
+// every graph gets full traversals from a few roots reported as traversed edges per second (Graph500 style,
+// edges of the reached component over traversal time, harmonic mean over roots) and random point-to-point
+// queries reported as latency percentiles
+// query results are cross checked between variants, hop counts of the BFS variants and costs of A* against
+// Dijkstra, and any mismatch fails the run
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchGraph
+{
+    std::string name;
+    bool undirected = false;
+    cyber::CSRGraph owned;
+    cyber::CSRGraphFile file;
+    cyber::CSRGraphView graph = {};
+    cyber::CSRGraph reverse; // empty when undirected
+    std::vector<int32_t> coords; // 3 per node when the generator has positions
+    bool euclidean = false; // coords heuristic, Manhattan on grids, straight line on geometric graphs
+
+    inline cyber::CSRGraphView Reverse() const { return undirected ? graph : reverse.View(); }
+};
+
+static uint64_t NextRandom(uint64_t& state)
+{
+    // splitmix64
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static double NextUnit(uint64_t& state)
+{
+    return double(NextRandom(state) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static void Finish(BenchGraph& g, uint32_t nodeCount, const std::vector<cyber::CSRWeightedEdge>& edges, bool undirected)
+{
+    g.undirected = undirected;
+    if (std::all_of(edges.begin(), edges.end(), [](const cyber::CSRWeightedEdge& e) { return e.weight == 1; }))
+    {
+        // unit weights build without a weight array, as callers of unweighted graphs would
+        std::vector<cyber::CSREdge> unweighted(edges.size());
+        for (size_t i = 0; i < edges.size(); ++i)
+            unweighted[i] = { edges[i].source, edges[i].target };
+        g.owned.BuildFromEdges(nodeCount, unweighted.data(), unweighted.size(), undirected);
+    }
+    else
+        g.owned.BuildFromEdges(nodeCount, edges.data(), edges.size(), undirected);
+    g.graph = g.owned.View();
+    if (!undirected)
+        g.reverse.BuildTranspose(g.graph);
+}
+
+// 4 connected grid, blocked cells stay as isolated nodes so ids match cell indices
+static void Grid2D(BenchGraph& g, uint32_t w, uint32_t h, uint32_t obstaclePercent, uint64_t seed)
+{
+    std::vector<uint8_t> blocked(size_t(w) * h);
+    for (uint8_t& b : blocked)
+        b = NextRandom(seed) % 100 < obstaclePercent;
+
+    std::vector<cyber::CSRWeightedEdge> edges;
+    g.coords.resize(size_t(w) * h * 3);
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            uint32_t v = y * w + x;
+            g.coords[v * 3 + 0] = int32_t(x);
+            g.coords[v * 3 + 1] = int32_t(y);
+            g.coords[v * 3 + 2] = 0;
+            if (blocked[v])
+                continue;
+            if (x + 1 < w && !blocked[v + 1])
+                edges.push_back({ v, v + 1, 1 });
+            if (y + 1 < h && !blocked[v + w])
+                edges.push_back({ v, v + w, 1 });
+        }
+    }
+
+    g.name = "grid2d " + std::to_string(w) + "x" + std::to_string(h) + " " + std::to_string(obstaclePercent) + "%";
+    Finish(g, w * h, edges, true);
+}
+
+// 6 connected voxel grid
+static void Grid3D(BenchGraph& g, uint32_t w, uint32_t h, uint32_t d, uint32_t obstaclePercent, uint64_t seed)
+{
+    const uint32_t layer = w * h;
+    std::vector<uint8_t> blocked(size_t(layer) * d);
+    for (uint8_t& b : blocked)
+        b = NextRandom(seed) % 100 < obstaclePercent;
+
+    std::vector<cyber::CSRWeightedEdge> edges;
+    g.coords.resize(size_t(layer) * d * 3);
+    for (uint32_t z = 0; z < d; ++z)
+    {
+        for (uint32_t y = 0; y < h; ++y)
+        {
+            for (uint32_t x = 0; x < w; ++x)
+            {
+                uint32_t v = z * layer + y * w + x;
+                g.coords[size_t(v) * 3 + 0] = int32_t(x);
+                g.coords[size_t(v) * 3 + 1] = int32_t(y);
+                g.coords[size_t(v) * 3 + 2] = int32_t(z);
+                if (blocked[v])
+                    continue;
+                if (x + 1 < w && !blocked[v + 1])
+                    edges.push_back({ v, v + 1, 1 });
+                if (y + 1 < h && !blocked[v + w])
+                    edges.push_back({ v, v + w, 1 });
+                if (z + 1 < d && !blocked[v + layer])
+                    edges.push_back({ v, v + layer, 1 });
+            }
+        }
+    }
+
+    g.name = "grid3d " + std::to_string(w) + "x" + std::to_string(h) + "x" + std::to_string(d) + " " + std::to_string(obstaclePercent) + "%";
+    Finish(g, layer * d, edges, true);
+}
+
+// Graph500 Kronecker generator, R-MAT quadrant probabilities a = 0.57, b = c = 0.19 with node ids scrambled so
+// high degree nodes are not clustered at low ids, self loops dropped, undirected
+static void Kronecker(BenchGraph& g, uint32_t scale, uint32_t edgeFactor, uint64_t seed)
+{
+    const uint32_t n = 1u << scale;
+    const double a = 0.57, b = 0.19, c = 0.19;
+
+    std::vector<uint32_t> perm(n);
+    for (uint32_t v = 0; v < n; ++v)
+        perm[v] = v;
+    for (uint32_t v = n - 1; v > 0; --v)
+        std::swap(perm[v], perm[NextRandom(seed) % (uint64_t(v) + 1)]);
+
+    std::vector<cyber::CSRWeightedEdge> edges;
+    edges.reserve(size_t(n) * edgeFactor);
+    for (size_t i = 0; i < size_t(n) * edgeFactor; ++i)
+    {
+        uint32_t source = 0, target = 0;
+        for (uint32_t bit = 0; bit < scale; ++bit)
+        {
+            double r = NextUnit(seed);
+            uint32_t row = r >= a + b ? 1 : 0;
+            uint32_t col = (r >= a && r < a + b) || r >= a + b + c ? 1 : 0;
+            source |= row << bit;
+            target |= col << bit;
+        }
+        if (source != target)
+            edges.push_back({ perm[source], perm[target], 1 });
+    }
+
+    g.name = "kronecker scale " + std::to_string(scale) + " ef " + std::to_string(edgeFactor);
+    Finish(g, n, edges, true);
+}
+
+// points on a 2^16 lattice linked when closer than radius, weights are the rounded up distance so the rounded
+// down straight line distance stays a consistent A* heuristic
+static void RandomGeometric(BenchGraph& g, uint32_t n, double averageDegree, uint64_t seed)
+{
+    const double side = 65536.0;
+    const double radius = std::sqrt(averageDegree / (3.14159265358979 * n)) * side;
+    const uint32_t cells = std::max(1u, uint32_t(side / radius));
+    const double cellSize = side / cells;
+
+    g.coords.resize(size_t(n) * 3);
+    std::vector<std::vector<uint32_t>> buckets(size_t(cells) * cells);
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        int32_t x = int32_t(NextRandom(seed) & 0xFFFF), y = int32_t(NextRandom(seed) & 0xFFFF);
+        g.coords[size_t(v) * 3 + 0] = x;
+        g.coords[size_t(v) * 3 + 1] = y;
+        g.coords[size_t(v) * 3 + 2] = 0;
+        uint32_t cx = std::min(cells - 1, uint32_t(x / cellSize)), cy = std::min(cells - 1, uint32_t(y / cellSize));
+        buckets[size_t(cy) * cells + cx].push_back(v);
+    }
+
+    std::vector<cyber::CSRWeightedEdge> edges;
+    for (uint32_t cy = 0; cy < cells; ++cy)
+    {
+        for (uint32_t cx = 0; cx < cells; ++cx)
+        {
+            for (uint32_t u : buckets[size_t(cy) * cells + cx])
+            {
+                for (uint32_t ny = cy > 0 ? cy - 1 : 0; ny <= std::min(cells - 1, cy + 1); ++ny)
+                {
+                    for (uint32_t nx = cx > 0 ? cx - 1 : 0; nx <= std::min(cells - 1, cx + 1); ++nx)
+                    {
+                        for (uint32_t v : buckets[size_t(ny) * cells + nx])
+                        {
+                            if (v <= u)
+                                continue;
+                            double dx = double(g.coords[size_t(u) * 3] - g.coords[size_t(v) * 3]);
+                            double dy = double(g.coords[size_t(u) * 3 + 1] - g.coords[size_t(v) * 3 + 1]);
+                            double distance = std::sqrt(dx * dx + dy * dy);
+                            if (distance <= radius)
+                                edges.push_back({ u, v, std::max(1u, uint32_t(std::ceil(distance))) });
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    g.euclidean = true;
+    g.name = "geometric " + std::to_string(n) + " deg " + std::to_string(uint32_t(averageDegree));
+    Finish(g, n, edges, true);
+}
+
+static bool LoadFile(BenchGraph& g, const char* path)
+{
+    if (!g.file.Open(path))
+        return false;
+
+    // the header does not record symmetry, treat files as directed
+    g.name = path;
+    g.graph = g.file.View();
+    g.reverse.BuildTranspose(g.graph);
+    return true;
+}
+
+struct CoordHeuristic
+{
+    const int32_t* coords;
+    uint32_t target;
+    bool euclidean;
+
+    inline uint32_t operator()(uint32_t node) const
+    {
+        const int32_t* a = coords + size_t(node) * 3;
+        const int32_t* b = coords + size_t(target) * 3;
+        int64_t dx = std::abs(int64_t(a[0]) - b[0]), dy = std::abs(int64_t(a[1]) - b[1]), dz = std::abs(int64_t(a[2]) - b[2]);
+        if (!euclidean)
+            return uint32_t(dx + dy + dz);
+        return uint32_t(std::floor(std::sqrt(double(dx * dx + dy * dy + dz * dz))));
+    }
+};
+
+struct Latencies
+{
+    std::vector<double> micros;
+    uint64_t work = 0; // nodes explored or settled where the search reports it
+    uint32_t found = 0;
+
+    void Print(const char* variant) const
+    {
+        std::vector<double> sorted = micros;
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0;
+        for (double m : sorted)
+            total += m;
+        auto percentile = [&](double p) { return sorted[std::min(sorted.size() - 1, size_t(p * sorted.size()))]; };
+
+        printf("  %-22s p50 %9.1f  p90 %9.1f  p99 %9.1f  max %9.1f us  %9.0f q/s  found %u/%zu", variant, percentile(0.5),
+            percentile(0.9), percentile(0.99), sorted.back(), total > 0 ? 1e6 * sorted.size() / total : 0.0, found, sorted.size());
+        if (work)
+            printf("  explored %.0f/q", double(work) / sorted.size());
+        printf("\n");
+    }
+};
+
+template<typename Fn>
+static double TimeMicros(Fn&& fn)
+{
+    Clock::time_point begin = Clock::now();
+    fn();
+    return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+}
+
+static size_t PeakResidentBytes()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#ifdef __APPLE__
+    return size_t(usage.ru_maxrss);
+#else
+    return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+static size_t GraphBytes(const cyber::CSRGraphView& graph)
+{
+    return (size_t(graph.node_count) + 1 + graph.edge_count + (graph.weights ? graph.edge_count : 0)) * sizeof(uint32_t);
+}
+
+static double MiB(size_t bytes)
+{
+    return double(bytes) / (1024.0 * 1024.0);
+}
+
+// returns the number of cross check failures
+static uint32_t RunGraph(BenchGraph& g, uint32_t queryCount, uint32_t rootCount, uint64_t seed)
+{
+    const cyber::CSRGraphView graph = g.graph;
+    const cyber::CSRGraphView reverse = g.Reverse();
+    const uint32_t n = graph.node_count;
+    uint32_t failures = 0;
+
+    printf("%s: %u nodes, %u edges%s%s\n", g.name.c_str(), n, graph.edge_count, g.undirected ? " (both directions)" : "",
+        graph.weights ? ", weighted" : "");
+
+    // queries and roots come from nodes with edges, isolated nodes (obstacles, unused Kronecker ids) make dull queries
+    std::vector<uint32_t> active;
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        if (graph.Degree(v) != 0)
+            active.push_back(v);
+    }
+    if (active.empty())
+    {
+        printf("  no edges, skipped\n\n");
+        return 0;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> queries(queryCount);
+    for (std::pair<uint32_t, uint32_t>& q : queries)
+        q = { active[NextRandom(seed) % active.size()], active[NextRandom(seed) % active.size()] };
+
+    cyber::BreadthFirstSearch bfs;
+    cyber::BidirectionalBFS bidirectional;
+    cyber::DirectionOptimizingBFS directionOptimizing;
+    cyber::DijkstraSearch dijkstra;
+    cyber::DijkstraSearch astar;
+
+    // A* uses coordinates when the generator has them, ALT landmarks otherwise
+    cyber::LandmarkIndex landmarks;
+    double landmarkMicros = 0;
+    if (g.coords.empty())
+        landmarkMicros = TimeMicros([&] { landmarks.Build(graph, reverse, 8, active[0]); });
+
+    // the BFSNode interface, the way game code usually holds graphs
+    std::vector<cyber::BFSNode> nodes(n);
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        nodes[v].id = v;
+        for (const uint32_t* itr = graph.NeighborsBegin(v); itr != graph.NeighborsEnd(v); ++itr)
+            nodes[v].neighbors.push_back(&nodes[*itr]);
+    }
+    cyber::BreadthFirstSearch nodeBfs;
+
+    // full traversals, warm up first so the timed runs reuse search memory
+    {
+        bfs.FindPathReversed(graph, active[0], cyber::invalid_node_id);
+        directionOptimizing.Search(graph, reverse, active[0]);
+        dijkstra.Search(graph, active[0]);
+
+        double inverseSum[3] = {};
+        uint64_t reachedEdges = 0;
+        for (uint32_t r = 0; r < rootCount; ++r)
+        {
+            uint32_t root = active[NextRandom(seed) % active.size()];
+
+            // an end id no node has makes the point-to-point BFS traverse the whole component
+            double bfsMicros = TimeMicros([&] { bfs.FindPathReversed(graph, root, cyber::invalid_node_id); });
+            double doMicros = TimeMicros([&] { directionOptimizing.Search(graph, reverse, root); });
+            double dijkstraMicros = TimeMicros([&] { dijkstra.Search(graph, root); });
+
+            uint64_t edges = 0;
+            const std::vector<uint32_t>& depths = directionOptimizing.Depths();
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                if (depths[v] != cyber::invalid_node_id)
+                    edges += graph.Degree(v);
+                if ((depths[v] != cyber::invalid_node_id) != (dijkstra.Cost(v) != cyber::DijkstraSearch::invalid_cost))
+                    ++failures;
+            }
+            reachedEdges += edges;
+
+            // harmonic mean of TEPS is the mean of time per edge, inverted
+            inverseSum[0] += bfsMicros / double(std::max<uint64_t>(edges, 1));
+            inverseSum[1] += doMicros / double(std::max<uint64_t>(edges, 1));
+            inverseSum[2] += dijkstraMicros / double(std::max<uint64_t>(edges, 1));
+        }
+
+        const char* names[3] = { "bfs", "direction-optimizing", "dijkstra" };
+        printf("  traversal, %u roots, %.0f edges reached on average\n", rootCount, double(reachedEdges) / rootCount);
+        for (uint32_t i = 0; i < 3; ++i)
+            printf("  %-22s %9.2f MTEPS\n", names[i], rootCount / inverseSum[i]);
+    }
+
+    // point-to-point queries, results cross checked against BFS hops and Dijkstra costs
+    Latencies lat[7];
+    std::vector<uint32_t> hops(queryCount), costs(queryCount);
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        const std::vector<uint32_t>* path = nullptr;
+        lat[0].micros.push_back(TimeMicros([&] { path = bfs.FindPathReversed(graph, start, end); }));
+        hops[i] = path ? uint32_t(path->size()) : 0;
+        lat[0].found += path ? 1 : 0;
+    }
+    std::vector<uint32_t> forward(n);
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        uint32_t length = 0;
+        lat[6].micros.push_back(TimeMicros([&] { length = bfs.FindPath(graph, start, end, forward.data(), n); }));
+        lat[6].found += length ? 1 : 0;
+        failures += length != hops[i] || (length && (forward[0] != start || forward[length - 1] != end));
+    }
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        const std::vector<cyber::BFSNode*>* path = nullptr;
+        lat[1].micros.push_back(TimeMicros([&] { path = nodeBfs.FindPathReversed(&nodes[start], &nodes[end]); }));
+        lat[1].found += path ? 1 : 0;
+        failures += (path ? uint32_t(path->size()) : 0) != hops[i];
+    }
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        const std::vector<uint32_t>* path = nullptr;
+        lat[2].micros.push_back(TimeMicros([&] { path = bidirectional.FindPathReversed(graph, reverse, start, end); }));
+        lat[2].work += bidirectional.ExploredNodes();
+        lat[2].found += path ? 1 : 0;
+        failures += (path ? uint32_t(path->size()) : 0) != hops[i];
+    }
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        const std::vector<uint32_t>* path = nullptr;
+        lat[3].micros.push_back(TimeMicros([&] { path = directionOptimizing.FindPathReversed(graph, reverse, start, end); }));
+        lat[3].found += path ? 1 : 0;
+        failures += (path ? uint32_t(path->size()) : 0) != hops[i];
+    }
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        const std::vector<uint32_t>* path = nullptr;
+        lat[4].micros.push_back(TimeMicros([&] { path = dijkstra.FindPathReversed(graph, start, end); }));
+        lat[4].work += dijkstra.SettledNodes();
+        lat[4].found += path ? 1 : 0;
+        costs[i] = path ? dijkstra.PathCost() : cyber::DijkstraSearch::invalid_cost;
+    }
+    for (uint32_t i = 0; i < queryCount; ++i)
+    {
+        uint32_t start = queries[i].first, end = queries[i].second;
+        const std::vector<uint32_t>* path = nullptr;
+        if (g.coords.empty())
+            lat[5].micros.push_back(TimeMicros([&] { path = astar.FindPathReversed(graph, start, end, landmarks.Heuristic(end)); }));
+        else
+            lat[5].micros.push_back(TimeMicros([&] { path = astar.FindPathReversed(graph, start, end, CoordHeuristic{ g.coords.data(), end, g.euclidean }); }));
+        lat[5].work += astar.SettledNodes();
+        lat[5].found += path ? 1 : 0;
+        failures += (path ? astar.PathCost() : cyber::DijkstraSearch::invalid_cost) != costs[i];
+    }
+
+    printf("  queries, %u random pairs\n", queryCount);
+    lat[0].Print("bfs");
+    lat[6].Print("bfs (forward span)");
+    lat[1].Print("bfs (BFSNode)");
+    lat[2].Print("bidirectional");
+    lat[3].Print("direction-optimizing");
+    lat[4].Print("dijkstra");
+    lat[5].Print(g.coords.empty() ? "a* (ALT, 8 landmarks)" : "a* (coordinates)");
+
+    size_t nodeBytes = nodes.size() * sizeof(cyber::BFSNode);
+    for (const cyber::BFSNode& node : nodes)
+        nodeBytes += node.neighbors.capacity() * sizeof(cyber::BFSNode*);
+    printf("  memory: csr %.1f MiB, transpose %.1f MiB, BFSNode graph %.1f MiB", MiB(GraphBytes(graph)),
+        g.undirected ? 0.0 : MiB(GraphBytes(reverse)), MiB(nodeBytes));
+    if (g.coords.empty())
+        printf(", landmarks %.1f MiB (%s, built in %.0f ms)", MiB(landmarks.MemoryBytes()), landmarks.IsCompact() ? "16-bit" : "32-bit",
+            landmarkMicros / 1000.0);
+    printf(", peak rss %.1f MiB\n", MiB(PeakResidentBytes()));
+
+    if (failures)
+        printf("  MISMATCH: %u results differ between variants\n", failures);
+    printf("\n");
+    return failures;
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t queryCount = 500;
+    uint32_t rootCount = 8;
+    bool small = false;
+    std::vector<const char*> files;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-q") == 0 && i + 1 < argc)
+            queryCount = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc)
+            rootCount = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--small") == 0)
+            small = true;
+        else if (argv[i][0] == '-')
+        {
+            printf("usage: %s [-q queries] [-r roots] [--small] [graph.cxg ...]\n", argv[0]);
+            return 1;
+        }
+        else
+            files.push_back(argv[i]);
+    }
+
+    uint32_t failures = 0;
+    uint64_t seed = 12345;
+    if (!files.empty())
+    {
+        for (const char* path : files)
+        {
+            BenchGraph g;
+            if (!LoadFile(g, path))
+            {
+                printf("%s: could not open\n", path);
+                return 1;
+            }
+            failures += RunGraph(g, queryCount, rootCount, seed);
+        }
+        return failures ? 1 : 0;
+    }
+
+    // one graph alive at a time keeps peak rss meaningful per graph
+    const uint32_t shift = small ? 2 : 0;
+    {
+        BenchGraph g;
+        Grid2D(g, 1024 >> shift, 1024 >> shift, 20, seed);
+        failures += RunGraph(g, queryCount, rootCount, seed);
+    }
+    {
+        BenchGraph g;
+        Grid3D(g, 96 >> shift, 96 >> shift, 96 >> shift, 15, seed);
+        failures += RunGraph(g, queryCount, rootCount, seed);
+    }
+    {
+        BenchGraph g;
+        Kronecker(g, 18 - 2 * shift, 16, seed);
+        failures += RunGraph(g, queryCount, rootCount, seed);
+    }
+    {
+        BenchGraph g;
+        RandomGeometric(g, 200000 >> (2 * shift), 10.0, seed);
+        failures += RunGraph(g, queryCount, rootCount, seed);
+    }
+    return failures ? 1 : 0;
+}
@@ -4,6 +4,7 @@
 #include <list>
 #include <vector>
 #include <stdint.h>
+#include <assert.h>
 
 
 
@@ -39,6 +40,16 @@ void poolalloctest()
 
 struct C1 { int x; };
 struct C2 { int x, y; };
+// points at itself, so only its move constructor can relocate it
+struct C3
+{
+    C3* self = this;
+    int value = 0;
+
+    C3() = default;
+    C3(C3&& other) noexcept : self(this), value(other.value) {}
+    ~C3() { self = nullptr; }
+};
 //REGISTER_ARCHETYPE(0, C1, C2);
 
 void UpdateEntityCallback(unsigned entity, C1& c1, C2& c2)
@@ -90,13 +101,69 @@ void ecstest()
     db.FilterArchetypes<C1, C2>(&filter);
 
     ArchetypeBase* pbase = &ts;
+
+    // growth relocates only created components, through the move constructor when not trivially relocatable
+    Archetype<C1, C3> tracked;
+    for (unsigned i = 0; i < 200; ++i)
+        tracked.GetComponent<C3>(tracked.CreateEntity()).value = int(i);
+    for (unsigned i = 0; i < 200; ++i)
+        assert(tracked.GetComponent<C3>(i).self == &tracked.GetComponent<C3>(i) && tracked.GetComponent<C3>(i).value == int(i));
     //reinterpret_cast<ARCHETYPE_CAST(0)*>(pbase)->UpdateEntities(UpdateEntityCallback);
 }
 
 
+void sparsesettest();
+void btreetest();
+void relocatetest();
+void intrusivetest();
+void compressedsequencetest();
+void csrbfstest();
+void nodebfstest();
+void directionoptimizingbfstest();
+void parallelbfstest();
+void bidirectionalbfstest();
+void multisourcebfstest();
+void shortestpathtest();
+void jumppointsearchtest();
+void hierarchicalpathtest();
+void incrementalplannertest();
+void reorderingtest();
+void csrgraphfiletest();
+void connectivitytest();
+void flowfieldtest();
+void pathqueryservicetest();
+void pathcachetest();
+void landmarktest();
+void dynamicgraphtest();
+void forwardpathtest();
+
 int main()
 {
     ecstest();
+    sparsesettest();
+    btreetest();
+    relocatetest();
+    intrusivetest();
+    compressedsequencetest();
+    csrbfstest();
+    nodebfstest();
+    directionoptimizingbfstest();
+    parallelbfstest();
+    bidirectionalbfstest();
+    multisourcebfstest();
+    shortestpathtest();
+    jumppointsearchtest();
+    hierarchicalpathtest();
+    incrementalplannertest();
+    reorderingtest();
+    csrgraphfiletest();
+    connectivitytest();
+    flowfieldtest();
+    pathqueryservicetest();
+    pathcachetest();
+    landmarktest();
+    dynamicgraphtest();
+    forwardpathtest();
 
     return 0;
 }
\ No newline at end of file
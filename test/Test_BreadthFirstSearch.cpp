@@ -0,0 +1,1676 @@
+#include "BreadthFirstSearch.hpp"
+#include "CSRGraph.hpp"
+#include "DirectionOptimizingBFS.hpp"
+#include "ParallelBFS.hpp"
+#include "BidirectionalBFS.hpp"
+#include "MultiSourceBFS.hpp"
+#include "ShortestPathSearch.hpp"
+#include "JumpPointSearch.hpp"
+#include "HierarchicalPathfinder.hpp"
+#include "IncrementalPlanner.hpp"
+#include "GraphReordering.hpp"
+#include "CSRGraphFile.hpp"
+#include "ConnectivityIndex.hpp"
+#include "FlowField.hpp"
+#include "PathQueryService.hpp"
+#include "PathCache.hpp"
+#include "LandmarkIndex.hpp"
+#include "DynamicGraph.hpp"
+
+#include <vector>
+#include <stdint.h>
+#include <assert.h>
+#include <algorithm>
+#include <queue>
+#include <functional>
+#include <cstdlib>
+#include <cstdio>
+#include <thread>
+#include <future>
+#include <atomic>
+#include <string>
+#include <cstddef>
+
+
+
+// w x h 4-connected grid as an undirected edge list
+static std::vector<cyber::CSREdge> GridEdges(uint32_t w, uint32_t h)
+{
+    std::vector<cyber::CSREdge> edges;
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            uint32_t n = y * w + x;
+            if (x + 1 < w) edges.push_back({ n, n + 1 });
+            if (y + 1 < h) edges.push_back({ n, n + w });
+        }
+    }
+    return edges;
+}
+
+// skewed random directed graph, low diameter with a few high degree hubs
+static std::vector<cyber::CSREdge> ScaleFreeEdges(uint32_t nodeCount, uint32_t edgeCount, uint32_t seed)
+{
+    std::vector<cyber::CSREdge> edges;
+    for (uint32_t i = 0; i < edgeCount; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t a = (seed >> 8) % nodeCount;
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t b = (seed >> 8) % nodeCount;
+        edges.push_back({ a, (a & b) % nodeCount });
+        edges.push_back({ (a | b) % nodeCount, b });
+    }
+    return edges;
+}
+
+// plain level-by-level hop counts for comparing against optimized searches
+static std::vector<uint32_t> ReferenceDepths(const cyber::CSRGraphView& graph, uint32_t source)
+{
+    std::vector<uint32_t> depths(graph.node_count, cyber::invalid_node_id);
+    std::vector<uint32_t> queue(1, source);
+    depths[source] = 0;
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        uint32_t u = queue[head];
+        for (const uint32_t* itr = graph.NeighborsBegin(u); itr != graph.NeighborsEnd(u); ++itr)
+        {
+            if (depths[*itr] == cyber::invalid_node_id)
+            {
+                depths[*itr] = depths[u] + 1;
+                queue.push_back(*itr);
+            }
+        }
+    }
+    return depths;
+}
+
+void csrbfstest()
+{
+    std::vector<cyber::CSREdge> edges = GridEdges(16, 16);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(16 * 16, edges.data(), edges.size(), true);
+    assert(graph.NodeCount() == 256 && graph.EdgeCount() == edges.size() * 2);
+    assert(graph.View().Degree(0) == 2 && graph.View().Degree(17) == 4);
+
+    cyber::BreadthFirstSearch bfs;
+    const std::vector<uint32_t>* path = bfs.FindPathReversed(graph, 0, 255);
+    assert(path && path->size() == 31 && path->front() == 255 && path->back() == 0);
+
+    // directed chain has no way back
+    cyber::CSREdge chain[] = { { 0, 1 }, { 1, 2 } };
+    cyber::CSRGraph directed;
+    directed.BuildFromEdges(3, chain, 2);
+    assert(bfs.FindPathReversed(directed, 0, 2) && !bfs.FindPathReversed(directed, 2, 0));
+
+    // converted from node pointers
+    cyber::BFSNode nodes[3];
+    nodes[0].neighbors = { &nodes[1] };
+    nodes[1].neighbors = { &nodes[0], &nodes[2] };
+    cyber::BFSNode* nodePtrs[] = { &nodes[0], &nodes[1], &nodes[2] };
+    cyber::CSRGraph converted;
+    converted.BuildFromNodes(nodePtrs, 3);
+    assert(converted.EdgeCount() == 3 && converted.targets[2] == 2);
+}
+
+void nodebfstest()
+{
+    // 8 x 8 grid, row 4 walled off except at x == 7
+    const uint32_t w = 8;
+    std::vector<cyber::BFSNode> nodes(w * w);
+    for (uint32_t i = 0; i < w * w; ++i)
+        nodes[i].id = i;
+
+    auto open = [&](uint32_t x, uint32_t y) { return y != 4 || x == 7; };
+    for (uint32_t y = 0; y < w; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            if (!open(x, y)) continue;
+            cyber::BFSNode& n = nodes[y * w + x];
+            if (x > 0 && open(x - 1, y)) n.neighbors.push_back(&nodes[y * w + x - 1]);
+            if (x + 1 < w && open(x + 1, y)) n.neighbors.push_back(&nodes[y * w + x + 1]);
+            if (y > 0 && open(x, y - 1)) n.neighbors.push_back(&nodes[(y - 1) * w + x]);
+            if (y + 1 < w && open(x, y + 1)) n.neighbors.push_back(&nodes[(y + 1) * w + x]);
+        }
+    }
+
+    // same object reused, each query starts from clean visited state
+    cyber::BreadthFirstSearch bfs;
+    for (int repeat = 0; repeat < 3; ++repeat)
+    {
+        const std::vector<cyber::BFSNode*>* path = bfs.FindPathReversed(&nodes[0], &nodes[7 * w]);
+        assert(path && path->size() == 22 && path->front() == &nodes[7 * w] && path->back() == &nodes[0]);
+        assert(bfs.FindPathReversed(&nodes[0], &nodes[4 * w]) == nullptr);
+    }
+}
+
+void directionoptimizingbfstest()
+{
+    std::vector<cyber::CSREdge> edges = ScaleFreeEdges(5000, 40000, 7);
+    cyber::CSRGraph graph, reverse;
+    graph.BuildFromEdges(5000, edges.data(), edges.size());
+    reverse.BuildTranspose(graph);
+
+    cyber::DirectionOptimizingBFS bfs;
+    uint32_t bottomUpSteps = 0;
+    for (uint32_t source = 0; source < 5000; source += 997)
+    {
+        bfs.Search(graph, reverse, source);
+        bottomUpSteps += bfs.BottomUpSteps();
+        assert(bfs.Depths() == ReferenceDepths(graph, source));
+
+        // every parent is one level up and links by a real edge
+        for (uint32_t v = 0; v < 5000; ++v)
+        {
+            uint32_t p = bfs.Parents()[v];
+            if (p == cyber::invalid_node_id || v == source) continue;
+            assert(bfs.Depths()[p] + 1 == bfs.Depths()[v]);
+        }
+    }
+    assert(bottomUpSteps > 0);
+
+    std::vector<uint32_t> depths = ReferenceDepths(graph, 1);
+    const std::vector<uint32_t>* path = bfs.FindPathReversed(graph, reverse, 1, 4321);
+    assert(depths[4321] == cyber::invalid_node_id ? path == nullptr : path->size() == depths[4321] + 1);
+
+    // queries only reset what the previous one reached, nothing may leak into the next search
+    for (uint32_t start = 3; start < 5000; start += 1231)
+    {
+        depths = ReferenceDepths(graph, start);
+        for (uint32_t end = 0; end < 5000; end += 613)
+        {
+            path = bfs.FindPathReversed(graph, reverse, start, end);
+            assert(depths[end] == cyber::invalid_node_id ? path == nullptr : path->size() == depths[end] + 1);
+        }
+        bfs.Search(graph, reverse, start);
+        assert(bfs.Depths() == depths);
+    }
+}
+
+void parallelbfstest()
+{
+    std::vector<cyber::CSREdge> edges = ScaleFreeEdges(20000, 160000, 11);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(20000, edges.data(), edges.size());
+
+    // small threshold so mid-sized levels are split across workers too
+    cyber::ParallelBFS bfs(4);
+    bfs.serial_threshold = 256;
+    for (uint32_t source = 0; source < 20000; source += 4999)
+    {
+        bfs.Search(graph, source);
+        assert(bfs.Depths() == ReferenceDepths(graph, source));
+
+        for (uint32_t v = 0; v < 20000; ++v)
+        {
+            uint32_t p = bfs.Parents()[v];
+            if (p == cyber::invalid_node_id || v == source) continue;
+            assert(bfs.Depths()[p] + 1 == bfs.Depths()[v]);
+        }
+    }
+
+    std::vector<cyber::CSREdge> grid = GridEdges(64, 64);
+    cyber::CSRGraph gridGraph;
+    gridGraph.BuildFromEdges(64 * 64, grid.data(), grid.size(), true);
+    const std::vector<uint32_t>* path = bfs.FindPathReversed(gridGraph, 0, 64 * 64 - 1);
+    assert(path != nullptr && path->size() == 127);
+    assert(path->front() == 64 * 64 - 1 && path->back() == 0);
+
+    // short queries followed by full searches, across graph sizes, see no state from earlier searches
+    for (uint32_t start = 7; start < 20000; start += 6011)
+    {
+        std::vector<uint32_t> depths = ReferenceDepths(graph, start);
+        for (uint32_t end = 0; end < 20000; end += 2503)
+        {
+            path = bfs.FindPathReversed(graph, start, end);
+            assert(depths[end] == cyber::invalid_node_id ? path == nullptr : path->size() == depths[end] + 1);
+        }
+        bfs.Search(graph, start);
+        assert(bfs.Depths() == depths);
+        path = bfs.FindPathReversed(gridGraph, 65, 64 * 64 - 2);
+        assert(path != nullptr && path->size() == 124);
+    }
+}
+
+void bidirectionalbfstest()
+{
+    std::vector<cyber::CSREdge> edges = ScaleFreeEdges(5000, 20000, 3);
+    cyber::CSRGraph graph, reverse;
+    graph.BuildFromEdges(5000, edges.data(), edges.size());
+    reverse.BuildTranspose(graph);
+
+    cyber::BidirectionalBFS bfs;
+    for (uint32_t start = 0; start < 5000; start += 619)
+    {
+        std::vector<uint32_t> depths = ReferenceDepths(graph, start);
+        for (uint32_t end = 1; end < 5000; end += 377)
+        {
+            const std::vector<uint32_t>* path = bfs.FindPathReversed(graph, reverse, start, end);
+            if (depths[end] == cyber::invalid_node_id)
+            {
+                assert(path == nullptr);
+                continue;
+            }
+
+            // shortest length, right ends and every hop a real edge
+            assert(path != nullptr && path->size() == depths[end] + 1);
+            assert(path->front() == end && path->back() == start);
+            for (size_t i = path->size() - 1; i > 0; --i)
+            {
+                uint32_t from = (*path)[i], to = (*path)[i - 1];
+                bool linked = std::find(graph.View().NeighborsBegin(from), graph.View().NeighborsEnd(from), to) != graph.View().NeighborsEnd(from);
+                assert(linked);
+            }
+        }
+    }
+
+    // meeting in the middle of a long grid path explores far less than a one sided search
+    std::vector<cyber::CSREdge> grid = GridEdges(128, 128);
+    cyber::CSRGraph gridGraph;
+    gridGraph.BuildFromEdges(128 * 128, grid.data(), grid.size(), true);
+    const std::vector<uint32_t>* path = bfs.FindPathReversed(gridGraph, gridGraph, 64 * 128 + 32, 64 * 128 + 96);
+    assert(path != nullptr && path->size() == 65);
+    assert(bfs.ExploredNodes() < 128 * 128 / 2);
+
+    path = bfs.FindPathReversed(gridGraph, gridGraph, 7, 7);
+    assert(path != nullptr && path->size() == 1);
+}
+
+void multisourcebfstest()
+{
+    std::vector<cyber::CSREdge> edges = ScaleFreeEdges(3000, 15000, 5);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(3000, edges.data(), edges.size());
+
+    // a partly filled 256 lane batch with a repeated source
+    std::vector<uint32_t> sources;
+    for (uint32_t i = 0; i < 150; ++i)
+        sources.push_back((i * 7919) % 3000);
+    sources.push_back(sources[3]);
+
+    cyber::MultiSourceBFS256 bfs;
+    bfs.Search(graph, sources.data(), uint32_t(sources.size()), true);
+    assert(bfs.SourceCount() == sources.size());
+    for (uint32_t lane = 0; lane < sources.size(); ++lane)
+    {
+        std::vector<uint32_t> expected = ReferenceDepths(graph, sources[lane]);
+        std::vector<uint32_t> depths(bfs.Depths(lane), bfs.Depths(lane) + 3000);
+        assert(depths == expected);
+    }
+
+    const std::vector<uint32_t>* path = bfs.FindPathReversed(5, 2999);
+    uint32_t expectedDepth = bfs.Depths(5)[2999];
+    assert(expectedDepth == cyber::invalid_node_id ? path == nullptr : path->size() == expectedDepth + 1 && path->back() == sources[5]);
+
+    // full 64 lane batch without parents
+    cyber::MultiSourceBFS64 bfs64;
+    bfs64.Search(graph, sources.data(), 64);
+    assert(bfs64.Parents(0) == nullptr);
+    for (uint32_t lane = 0; lane < 64; lane += 9)
+    {
+        std::vector<uint32_t> expected = ReferenceDepths(graph, sources[lane]);
+        std::vector<uint32_t> depths(bfs64.Depths(lane), bfs64.Depths(lane) + 3000);
+        assert(depths == expected);
+    }
+}
+
+// O(E log V) binary heap Dijkstra with lazy deletion as ground truth
+static std::vector<uint32_t> ReferenceCosts(const cyber::CSRGraphView& graph, uint32_t source)
+{
+    typedef std::pair<uint32_t, uint32_t> Entry; // cost, node
+    std::vector<uint32_t> costs(graph.node_count, 0xFFFFFFFF);
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    costs[source] = 0;
+    open.push({ 0, source });
+    while (!open.empty())
+    {
+        Entry top = open.top();
+        open.pop();
+        if (top.first != costs[top.second])
+            continue;
+        for (uint32_t e = graph.offsets[top.second]; e != graph.offsets[top.second + 1]; ++e)
+        {
+            uint32_t cost = top.first + graph.Weight(e);
+            if (cost < costs[graph.targets[e]])
+            {
+                costs[graph.targets[e]] = cost;
+                open.push({ cost, graph.targets[e] });
+            }
+        }
+    }
+    return costs;
+}
+
+template<typename Search>
+static void CheckShortestPaths(Search& search, const cyber::CSRGraphView& graph)
+{
+    for (uint32_t source = 0; source < graph.node_count; source += 401)
+    {
+        std::vector<uint32_t> expected = ReferenceCosts(graph, source);
+        search.Search(graph, source);
+        for (uint32_t v = 0; v < graph.node_count; ++v)
+            assert(search.Cost(v) == expected[v]);
+
+        uint32_t end = (source * 31 + 17) % graph.node_count;
+        const std::vector<uint32_t>* path = search.FindPathReversed(graph, source, end);
+        assert(expected[end] == 0xFFFFFFFF ? path == nullptr : search.PathCost() == expected[end]);
+        if (path)
+        {
+            // path edges add up to the reported cost
+            uint32_t total = 0;
+            for (size_t i = path->size() - 1; i > 0; --i)
+            {
+                uint32_t from = (*path)[i], to = (*path)[i - 1];
+                uint32_t best = 0xFFFFFFFF;
+                for (uint32_t e = graph.offsets[from]; e != graph.offsets[from + 1]; ++e)
+                    best = graph.targets[e] == to && graph.Weight(e) < best ? graph.Weight(e) : best;
+                total += best;
+            }
+            assert(total == expected[end] && path->front() == end && path->back() == source);
+        }
+    }
+}
+
+void shortestpathtest()
+{
+    std::vector<cyber::CSREdge> plain = ScaleFreeEdges(2000, 12000, 9);
+    std::vector<cyber::CSRWeightedEdge> edges;
+    uint32_t seed = 12345;
+    for (const cyber::CSREdge& e : plain)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        edges.push_back({ e.source, e.target, 1 + (seed >> 24) });
+    }
+
+    cyber::CSRGraph graph, reverse;
+    graph.BuildFromEdges(2000, edges.data(), edges.size());
+    reverse.BuildTranspose(graph);
+    assert(reverse.weights.size() == graph.weights.size());
+
+    cyber::DijkstraSearch dijkstra;
+    cyber::RadixDijkstraSearch radix;
+    CheckShortestPaths(dijkstra, graph);
+    CheckShortestPaths(radix, graph);
+
+    // unweighted views cost 1 per edge, same as BFS hop counts
+    cyber::CSRGraph hops;
+    hops.BuildFromEdges(2000, plain.data(), plain.size());
+    dijkstra.Search(hops, 0);
+    std::vector<uint32_t> depths = ReferenceDepths(hops, 0);
+    for (uint32_t v = 0; v < 2000; ++v)
+        assert(dijkstra.Cost(v) == depths[v]);
+
+    // A* on a unit grid with a manhattan heuristic settles fewer nodes than Dijkstra for the same cost
+    const uint32_t w = 100;
+    std::vector<cyber::CSREdge> grid = GridEdges(w, w);
+    cyber::CSRGraph gridGraph;
+    gridGraph.BuildFromEdges(w * w, grid.data(), grid.size(), true);
+    uint32_t goal = 70 * w + 80;
+    auto manhattan = [&](uint32_t n)
+    {
+        uint32_t x = n % w, y = n / w;
+        return (x > goal % w ? x - goal % w : goal % w - x) + (y > goal / w ? y - goal / w : goal / w - y);
+    };
+
+    const std::vector<uint32_t>* path = dijkstra.FindPathReversed(gridGraph, 10 * w + 5, goal);
+    assert(path != nullptr && dijkstra.PathCost() == 135);
+    uint32_t dijkstraSettled = dijkstra.SettledNodes();
+    path = dijkstra.FindPathReversed(gridGraph, 10 * w + 5, goal, manhattan);
+    assert(path != nullptr && dijkstra.PathCost() == 135 && path->size() == 136);
+    assert(dijkstra.SettledNodes() < dijkstraSettled);
+    path = radix.FindPathReversed(gridGraph, 10 * w + 5, goal, manhattan);
+    assert(path != nullptr && radix.PathCost() == 135);
+
+    // BFSNode graph with costs matches its CSR conversion
+    std::vector<cyber::BFSNode> nodes(300);
+    std::vector<cyber::BFSNode*> nodePtrs;
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        nodes[i].id = i;
+        nodePtrs.push_back(&nodes[i]);
+    }
+    for (uint32_t i = 0; i < 300; ++i)
+    {
+        for (uint32_t k = 1; k <= 3; ++k)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            nodes[i].neighbors.push_back(&nodes[(seed >> 8) % 300]);
+            nodes[i].costs.push_back(1 + (seed >> 27));
+        }
+    }
+    cyber::CSRGraph nodeGraph;
+    nodeGraph.BuildFromNodes(nodePtrs.data(), nodePtrs.size());
+    std::vector<uint32_t> nodeCosts = ReferenceCosts(nodeGraph, 0);
+    for (uint32_t end = 1; end < 300; end += 23)
+    {
+        const std::vector<cyber::BFSNode*>* nodePath = radix.FindPathReversed(&nodes[0], &nodes[end]);
+        assert(nodeCosts[end] == 0xFFFFFFFF ? nodePath == nullptr : radix.PathCost() == nodeCosts[end] && nodePath->back() == &nodes[0]);
+    }
+}
+
+// random occupancy grid, density in 1/256ths
+static void RandomGrid(cyber::GridMap& grid, uint32_t w, uint32_t h, uint32_t density, uint32_t seed)
+{
+    grid.Resize(w, h);
+    for (uint32_t y = 0; y < h; ++y)
+    {
+        for (uint32_t x = 0; x < w; ++x)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            grid.SetBlocked(x, y, (seed >> 24) < density);
+        }
+    }
+}
+
+// materialized 8-connected graph with the same costs and corner rule as JumpPointSearch
+static void GridGraph(const cyber::GridMap& grid, cyber::CSRGraph& graph)
+{
+    std::vector<cyber::CSRWeightedEdge> edges;
+    for (int32_t y = 0; y < int32_t(grid.Height()); ++y)
+    {
+        for (int32_t x = 0; x < int32_t(grid.Width()); ++x)
+        {
+            if (grid.IsBlocked(x, y)) continue;
+            for (int32_t dy = -1; dy <= 1; ++dy)
+            {
+                for (int32_t dx = -1; dx <= 1; ++dx)
+                {
+                    if ((dx == 0 && dy == 0) || grid.IsBlocked(x + dx, y + dy)) continue;
+                    if (dx != 0 && dy != 0 && (grid.IsBlocked(x + dx, y) || grid.IsBlocked(x, y + dy))) continue;
+                    uint32_t cost = dx != 0 && dy != 0 ? cyber::JumpPointSearch::diagonal_cost : cyber::JumpPointSearch::straight_cost;
+                    edges.push_back({ grid.CellId(x, y), grid.CellId(x + dx, y + dy), cost });
+                }
+            }
+        }
+    }
+    graph.BuildFromEdges(grid.CellCount(), edges.data(), edges.size());
+}
+
+void jumppointsearchtest()
+{
+    cyber::JumpPointSearch jps;
+    cyber::DijkstraSearch dijkstra;
+    std::vector<uint32_t> cells;
+
+    // widths straddle word boundaries so scans cross padded words
+    const uint32_t sizes[][2] = { { 40, 30 }, { 64, 64 }, { 130, 70 }, { 200, 129 } };
+    for (const uint32_t* size : sizes)
+    {
+        for (uint32_t density = 0; density <= 100; density += 50)
+        {
+            cyber::GridMap grid;
+            RandomGrid(grid, size[0], size[1], density, size[0] * 7 + density);
+            cyber::CSRGraph graph;
+            GridGraph(grid, graph);
+
+            for (uint32_t q = 0; q < 40; ++q)
+            {
+                uint32_t start = (q * 7919u) % grid.CellCount();
+                uint32_t end = (q * 104729u + 13) % grid.CellCount();
+                const std::vector<uint32_t>* path = jps.FindPathReversed(grid, start, end);
+                bool blocked = grid.IsBlocked(grid.CellX(start), grid.CellY(start)) || grid.IsBlocked(grid.CellX(end), grid.CellY(end));
+                const std::vector<uint32_t>* expected = blocked ? nullptr : dijkstra.FindPathReversed(graph, start, end);
+                assert((path == nullptr) == (expected == nullptr));
+                if (!path) continue;
+                assert(jps.PathCost() == dijkstra.PathCost());
+                assert(path->front() == end && path->back() == start);
+
+                // expanded cells are free, adjacent, never cut a corner and add up to the cost
+                cyber::JumpPointSearch::ExpandPath(grid, *path, cells);
+                uint32_t cost = 0;
+                for (size_t i = 1; i < cells.size(); ++i)
+                {
+                    int32_t x0 = grid.CellX(cells[i - 1]), y0 = grid.CellY(cells[i - 1]);
+                    int32_t x1 = grid.CellX(cells[i]), y1 = grid.CellY(cells[i]);
+                    assert(!grid.IsBlocked(x1, y1) && std::abs(x1 - x0) <= 1 && std::abs(y1 - y0) <= 1);
+                    assert(x0 == x1 || y0 == y1 || (!grid.IsBlocked(x1, y0) && !grid.IsBlocked(x0, y1)));
+                    cost += cyber::JumpPointSearch::OctileDistance(x0, y0, x1, y1);
+                }
+                assert(cost == jps.PathCost());
+            }
+        }
+    }
+
+    // open field needs only a couple of jump points
+    cyber::GridMap open;
+    open.Resize(300, 300);
+    const std::vector<uint32_t>* path = jps.FindPathReversed(open, open.CellId(5, 5), open.CellId(290, 200));
+    assert(path != nullptr && path->size() <= 3 && jps.ExpandedNodes() < 50);
+    assert(jps.PathCost() == cyber::JumpPointSearch::OctileDistance(5, 5, 290, 200));
+}
+
+// refined cells are free 8-connected steps without corner cutting, returns their total cost
+static uint32_t GridPathCost(const cyber::GridMap& grid, const std::vector<uint32_t>& cells)
+{
+    uint32_t cost = 0;
+    for (size_t i = 1; i < cells.size(); ++i)
+    {
+        int32_t x0 = grid.CellX(cells[i - 1]), y0 = grid.CellY(cells[i - 1]);
+        int32_t x1 = grid.CellX(cells[i]), y1 = grid.CellY(cells[i]);
+        assert(!grid.IsBlocked(x1, y1) && std::abs(x1 - x0) <= 1 && std::abs(y1 - y0) <= 1 && cells[i] != cells[i - 1]);
+        assert(x0 == x1 || y0 == y1 || (!grid.IsBlocked(x1, y0) && !grid.IsBlocked(x0, y1)));
+        cost += cyber::JumpPointSearch::OctileDistance(x0, y0, x1, y1);
+    }
+    return cost;
+}
+
+void hierarchicalpathtest()
+{
+    cyber::GridMap grid;
+    RandomGrid(grid, 203, 150, 50, 77);
+
+    cyber::HierarchicalPathfinder hpa;
+    hpa.Build(grid, 16);
+    cyber::JumpPointSearch jps;
+    std::vector<uint32_t> cells;
+
+    uint64_t hpaTotal = 0, optimalTotal = 0;
+    for (uint32_t q = 0; q < 60; ++q)
+    {
+        uint32_t start = (q * 7919u) % grid.CellCount();
+        uint32_t end = (q * 104729u + 13) % grid.CellCount();
+        const std::vector<uint32_t>* path = hpa.FindPathReversed(start, end);
+        const std::vector<uint32_t>* expected = jps.FindPathReversed(grid, start, end);
+        assert((path == nullptr) == (expected == nullptr));
+        if (!path) continue;
+
+        // refined path is valid, ends right and costs what the abstract search reported
+        assert(path->front() == end && path->back() == start);
+        hpa.RefinePath(*path, cells);
+        assert(cells.front() == end && cells.back() == start);
+        assert(GridPathCost(grid, cells) == hpa.PathCost());
+        assert(hpa.PathCost() >= jps.PathCost());
+        hpaTotal += hpa.PathCost();
+        optimalTotal += jps.PathCost();
+    }
+    assert(hpaTotal * 100 <= optimalTotal * 110);
+    assert(hpa.RebuiltClusters() == 0);
+
+    // an interior edit rebuilds one cluster, a border edit both sides, and results match a fresh build
+    grid.SetBlocked(40, 40, !grid.IsBlocked(40, 40));
+    hpa.CellChanged(40, 40);
+    hpa.FindPathReversed(0, 1);
+    assert(hpa.RebuiltClusters() == 1);
+
+    for (uint32_t y = 0; y < 150; ++y)
+    {
+        grid.SetBlocked(47, y, y != 100);
+        hpa.CellChanged(47, y);
+    }
+    cyber::HierarchicalPathfinder fresh;
+    fresh.Build(grid, 16);
+    for (uint32_t q = 0; q < 30; ++q)
+    {
+        uint32_t start = grid.CellId(q % 40, (q * 37) % 150);
+        uint32_t end = grid.CellId(60 + q * 3, (q * 53) % 150);
+        const std::vector<uint32_t>* path = hpa.FindPathReversed(start, end);
+        if (q == 0)
+            assert(hpa.RebuiltClusters() == 2 * 10);
+        uint32_t cost = path ? hpa.PathCost() : 0;
+        const std::vector<uint32_t>* freshPath = fresh.FindPathReversed(start, end);
+        assert((path == nullptr) == (freshPath == nullptr) && (!path || cost == fresh.PathCost()));
+        assert((path == nullptr) == (jps.FindPathReversed(grid, start, end) == nullptr));
+    }
+}
+
+// grid distance lower bound for unit or larger edge costs
+struct GridManhattan
+{
+    uint32_t width = 1;
+    inline uint32_t operator()(uint32_t a, uint32_t b) const
+    {
+        uint32_t ax = a % width, ay = a / width, bx = b % width, by = b / width;
+        return (ax > bx ? ax - bx : bx - ax) + (ay > by ? ay - by : by - ay);
+    }
+};
+
+void incrementalplannertest()
+{
+    // grid so that edits stay local, random costs on a directed edge list
+    const uint32_t w = 60;
+    std::vector<cyber::CSREdge> grid = GridEdges(w, w);
+    std::vector<cyber::CSRWeightedEdge> edges;
+    uint32_t seed = 99;
+    for (const cyber::CSREdge& e : grid)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        edges.push_back({ e.source, e.target, 1 + (seed >> 28) });
+        edges.push_back({ e.target, e.source, 1 + (seed >> 28) });
+    }
+
+    // zero cost cycle between 1 and 2, the path extraction has to leave it through 2 -> 3
+    {
+        cyber::CSRWeightedEdge cycle[] = { { 0, 1, 1 }, { 1, 2, 0 }, { 2, 1, 0 }, { 2, 3, 1 } };
+        cyber::CSRGraph cycleGraph;
+        cycleGraph.BuildFromEdges(4, cycle, 4);
+        cyber::IncrementalPlanner<> cyclePlanner;
+        cyclePlanner.Reset(cycleGraph, 0, 3);
+        const std::vector<uint32_t>* cyclePath = cyclePlanner.FindPathReversed();
+        assert(cyclePath && cyclePlanner.PathCost() == 2);
+        assert(*cyclePath == std::vector<uint32_t>({ 3, 2, 1, 0 }));
+    }
+    // zero cost plateau where the greedy walk picks the dead end side first and needs the fallback
+    {
+        cyber::CSRWeightedEdge plateau[] = { { 0, 1, 0 }, { 1, 0, 0 }, { 1, 2, 0 }, { 2, 3, 1 } };
+        cyber::CSRGraph plateauGraph;
+        plateauGraph.BuildFromEdges(4, plateau, 4);
+        cyber::IncrementalPlanner<> plateauPlanner;
+        plateauPlanner.Reset(plateauGraph, 1, 3);
+        const std::vector<uint32_t>* plateauPath = plateauPlanner.FindPathReversed();
+        assert(plateauPath && plateauPlanner.PathCost() == 1);
+        assert(*plateauPath == std::vector<uint32_t>({ 3, 2, 1 }));
+    }
+
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(w * w, edges.data(), edges.size());
+
+    uint32_t start = 0, goal = w * w - 1;
+    cyber::IncrementalPlanner<> planner;
+    planner.Reset(graph, start, goal);
+    GridManhattan manhattan;
+    manhattan.width = w;
+    cyber::IncrementalPlanner<GridManhattan> guided;
+    guided.Reset(graph, start, goal, manhattan);
+    cyber::DijkstraSearch dijkstra;
+
+    const std::vector<uint32_t>* path = planner.FindPathReversed();
+    assert(path != nullptr && path->front() == goal && path->back() == start);
+    dijkstra.FindPathReversed(graph, start, goal);
+    assert(planner.PathCost() == dijkstra.PathCost());
+    uint32_t initialExpanded = planner.ExpandedNodes();
+
+    for (uint32_t round = 0; round < 30; ++round)
+    {
+        // the agent advances a step, then a batch of edges near it change or fail
+        if (path->size() > 2)
+            start = (*path)[path->size() - 2];
+        planner.MoveStart(start);
+        guided.MoveStart(start);
+
+        std::vector<cyber::EdgeCostUpdate> updates;
+        for (uint32_t k = 0; k < 6; ++k)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            uint32_t e = (seed >> 8) % uint32_t(edges.size());
+            seed = seed * 1664525u + 1013904223u;
+            uint32_t cost = (seed >> 24) < 40 ? cyber::IncrementalPlanner<>::invalid_cost : 1 + (seed >> 28);
+            edges[e].weight = cost;
+            updates.push_back({ edges[e].source, edges[e].target, cost });
+        }
+        planner.UpdateEdges(updates.data(), updates.size());
+        guided.UpdateEdges(updates.data(), updates.size());
+        for (const cyber::EdgeCostUpdate& u : updates)
+            assert(planner.EdgeCost(u.source, u.target) == u.cost);
+
+        // reference rebuilt without removed edges
+        std::vector<cyber::CSRWeightedEdge> live;
+        for (const cyber::CSRWeightedEdge& e : edges)
+        {
+            if (e.weight != cyber::IncrementalPlanner<>::invalid_cost)
+                live.push_back(e);
+        }
+        cyber::CSRGraph reference;
+        reference.BuildFromEdges(w * w, live.data(), live.size());
+        const std::vector<uint32_t>* expected = dijkstra.FindPathReversed(reference, start, goal);
+
+        const std::vector<uint32_t>* guidedPath = guided.FindPathReversed();
+        assert((guidedPath == nullptr) == (expected == nullptr) && (!guidedPath || guided.PathCost() == dijkstra.PathCost()));
+        path = planner.FindPathReversed();
+        assert((path == nullptr) == (expected == nullptr));
+        if (!path)
+            break;
+        assert(planner.PathCost() == dijkstra.PathCost());
+        assert(planner.ExpandedNodes() < initialExpanded);
+        assert(path->front() == goal && path->back() == start);
+        for (size_t i = path->size() - 1; i > 0; --i)
+            assert(planner.EdgeCost((*path)[i], (*path)[i - 1]) != cyber::IncrementalPlanner<>::invalid_cost);
+    }
+}
+
+// largest |source - target| over all edges
+static uint32_t Bandwidth(const cyber::CSRGraphView& graph)
+{
+    uint32_t bandwidth = 0;
+    for (uint32_t n = 0; n < graph.node_count; ++n)
+    {
+        for (const uint32_t* itr = graph.NeighborsBegin(n); itr != graph.NeighborsEnd(n); ++itr)
+            bandwidth = std::max(bandwidth, *itr > n ? *itr - n : n - *itr);
+    }
+    return bandwidth;
+}
+
+// relabeled graph has exactly the original edges and hop counts under the mapping
+static void CheckPermuted(const cyber::CSRGraphView& graph, const cyber::NodePermutation& perm)
+{
+    const uint32_t n = graph.node_count;
+    assert(perm.new_to_old.size() == n && perm.old_to_new.size() == n);
+    for (uint32_t i = 0; i < n; ++i)
+        assert(perm.old_to_new[perm.new_to_old[i]] == i);
+
+    cyber::CSRGraph permuted;
+    permuted.BuildPermuted(graph, perm);
+    assert(permuted.EdgeCount() == graph.edge_count);
+
+    std::vector<std::pair<uint32_t, uint32_t>> expected, actual;
+    for (uint32_t u = 0; u < n; ++u)
+    {
+        for (const uint32_t* itr = graph.NeighborsBegin(u); itr != graph.NeighborsEnd(u); ++itr)
+            expected.push_back({ perm.old_to_new[u], perm.old_to_new[*itr] });
+        for (const uint32_t* itr = permuted.View().NeighborsBegin(u); itr != permuted.View().NeighborsEnd(u); ++itr)
+            actual.push_back({ u, *itr });
+    }
+    std::sort(expected.begin(), expected.end());
+    assert(expected == actual);
+
+    std::vector<uint32_t> depths = ReferenceDepths(graph, 3);
+    std::vector<uint32_t> permutedDepths = ReferenceDepths(permuted, perm.old_to_new[3]);
+    for (uint32_t v = 0; v < n; ++v)
+        assert(permutedDepths[perm.old_to_new[v]] == depths[v]);
+}
+
+void reorderingtest()
+{
+    // grid with scrambled ids, the orderings should recover a narrow band
+    const uint32_t w = 40;
+    std::vector<cyber::CSREdge> edges = GridEdges(w, w);
+    std::vector<uint32_t> scramble(w * w);
+    for (uint32_t i = 0; i < w * w; ++i)
+        scramble[i] = i;
+    uint32_t seed = 5;
+    for (uint32_t i = w * w - 1; i > 0; --i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        std::swap(scramble[i], scramble[(seed >> 8) % (i + 1)]);
+    }
+    for (cyber::CSREdge& e : edges)
+        e = { scramble[e.source], scramble[e.target] };
+
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(w * w, edges.data(), edges.size(), true);
+    uint32_t scrambledBandwidth = Bandwidth(graph);
+
+    cyber::NodePermutation perm;
+    cyber::CSRGraph permuted;
+
+    cyber::ReverseCuthillMcKeeOrder(graph, perm);
+    CheckPermuted(graph, perm);
+    permuted.BuildPermuted(graph, perm);
+    assert(Bandwidth(permuted) <= 2 * w && Bandwidth(permuted) * 10 < scrambledBandwidth);
+
+    cyber::BFSOrder(graph, 0, perm);
+    CheckPermuted(graph, perm);
+    permuted.BuildPermuted(graph, perm);
+    assert(Bandwidth(permuted) <= 2 * w);
+
+    cyber::DFSOrder(graph, 0, perm);
+    CheckPermuted(graph, perm);
+
+    cyber::GorderLiteOrder(graph, perm);
+    CheckPermuted(graph, perm);
+
+    // directed, weighted, several components and hubs
+    std::vector<cyber::CSREdge> scaleFree = ScaleFreeEdges(3000, 9000, 21);
+    std::vector<cyber::CSRWeightedEdge> weighted;
+    for (const cyber::CSREdge& e : scaleFree)
+        weighted.push_back({ e.source, e.target, 1 + (e.source ^ e.target) % 7 });
+    cyber::CSRGraph directed;
+    directed.BuildFromEdges(3000, weighted.data(), weighted.size());
+
+    cyber::DegreeSortOrder(directed, perm);
+    CheckPermuted(directed, perm);
+    for (uint32_t i = 1; i < 3000; ++i)
+        assert(directed.View().Degree(perm.new_to_old[i - 1]) >= directed.View().Degree(perm.new_to_old[i]));
+
+    cyber::GorderLiteOrder(directed, perm, 5, 16);
+    CheckPermuted(directed, perm);
+    cyber::ReverseCuthillMcKeeOrder(directed, perm);
+    CheckPermuted(directed, perm);
+    cyber::DFSOrder(directed, 7, perm);
+    CheckPermuted(directed, perm);
+    assert(perm.new_to_old[0] == 7);
+
+    // weights follow their edges
+    permuted.BuildPermuted(directed, perm);
+    cyber::DijkstraSearch dijkstra;
+    dijkstra.Search(directed, 7);
+    std::vector<uint32_t> costs(3000);
+    for (uint32_t v = 0; v < 3000; ++v)
+        costs[v] = dijkstra.Cost(v);
+    dijkstra.Search(permuted, perm.old_to_new[7]);
+    for (uint32_t v = 0; v < 3000; ++v)
+        assert(dijkstra.Cost(perm.old_to_new[v]) == costs[v]);
+}
+
+static bool SameGraph(const cyber::CSRGraphView& a, const cyber::CSRGraphView& b)
+{
+    if (a.node_count != b.node_count || a.edge_count != b.edge_count || (a.weights == nullptr) != (b.weights == nullptr))
+        return false;
+    if (!std::equal(a.offsets, a.offsets + a.node_count + 1, b.offsets) || !std::equal(a.targets, a.targets + a.edge_count, b.targets))
+        return false;
+    return a.weights == nullptr || std::equal(a.weights, a.weights + a.edge_count, b.weights);
+}
+
+void csrgraphfiletest()
+{
+    const char* graphPath = "cx_graph_file_test.bin";
+    const char* edgesPath = "cx_graph_file_test.txt";
+
+    std::vector<cyber::CSREdge> scaleFree = ScaleFreeEdges(2000, 7000, 5);
+    cyber::CSRGraph unweighted;
+    unweighted.BuildFromEdges(2000, scaleFree.data(), scaleFree.size());
+    std::vector<cyber::CSRWeightedEdge> weightedEdges;
+    for (const cyber::CSREdge& e : scaleFree)
+        weightedEdges.push_back({ e.source, e.target, 1 + (e.source * 7 + e.target) % 11 });
+    cyber::CSRGraph weighted;
+    weighted.BuildFromEdges(2000, weightedEdges.data(), weightedEdges.size());
+
+    // round trips map the arrays back unchanged and 64 byte aligned
+    cyber::CSRGraphFile file;
+    bool ok = cyber::CSRGraphFile::Write(graphPath, unweighted);
+    assert(ok);
+    ok = file.Open(graphPath, true);
+    assert(ok && file.IsOpen());
+    assert(SameGraph(file.View(), unweighted));
+    assert(uintptr_t(file.View().targets) % 64 == 0);
+
+    ok = cyber::CSRGraphFile::Write(graphPath, weighted);
+    assert(ok);
+    ok = file.Open(graphPath, true);
+    assert(ok && SameGraph(file.View(), weighted));
+    assert(uintptr_t(file.View().weights) % 64 == 0);
+
+    // searches run straight on the mapping
+    cyber::DijkstraSearch dijkstra;
+    dijkstra.Search(weighted, 3);
+    std::vector<uint32_t> costs(2000);
+    for (uint32_t v = 0; v < 2000; ++v)
+        costs[v] = dijkstra.Cost(v);
+    dijkstra.Search(file, 3);
+    for (uint32_t v = 0; v < 2000; ++v)
+        assert(dijkstra.Cost(v) == costs[v]);
+    file.Close();
+    assert(!file.IsOpen() && file.View().node_count == 0);
+
+    // a flipped payload byte only fails the checksum, a cut file fails the structure check
+    FILE* f = fopen(graphPath, "r+b");
+    assert(f);
+    fseek(f, -8, SEEK_END);
+    fputc(0x5A, f);
+    fclose(f);
+    ok = file.Open(graphPath, false);
+    assert(ok);
+    ok = file.Open(graphPath, true);
+    assert(!ok && !file.IsOpen());
+
+    // a section offset that wraps the bounds arithmetic back into the file is rejected, checksum or not
+    ok = cyber::CSRGraphFile::Write(graphPath, weighted);
+    assert(ok);
+    f = fopen(graphPath, "r+b");
+    assert(f);
+    uint64_t wrapping = ~uint64_t(0) - 63;
+    fseek(f, long(offsetof(cyber::CSRFileHeader, targets_offset)), SEEK_SET);
+    fwrite(&wrapping, sizeof(wrapping), 1, f);
+    fclose(f);
+    ok = file.Open(graphPath, false);
+    assert(!ok && !file.IsOpen());
+
+    cyber::CSRGraph empty;
+    empty.offsets.push_back(0);
+    ok = cyber::CSRGraphFile::Write(graphPath, empty);
+    assert(ok);
+    ok = file.Open(graphPath, true);
+    assert(ok && file.View().node_count == 0 && file.View().edge_count == 0);
+    file.Close();
+
+    ok = file.Open("cx_graph_file_missing.bin");
+    assert(!ok);
+
+    // text edge lists
+    f = fopen(edgesPath, "w");
+    assert(f);
+    fprintf(f, "# comment\n%% comment\n\n");
+    // lines longer than any read buffer stay one line
+    fprintf(f, "# %s\n", std::string(1000, 'x').c_str());
+    for (const cyber::CSRWeightedEdge& e : weightedEdges)
+        fprintf(f, "%s%u\t%u %u\n", &e == &weightedEdges[5] ? std::string(600, ' ').c_str() : "", e.source, e.target, e.weight);
+    fclose(f);
+    ok = cyber::CSRGraphFile::ConvertEdgeList(edgesPath, graphPath);
+    assert(ok);
+    ok = file.Open(graphPath, true);
+    assert(ok && SameGraph(file.View(), weighted));
+
+    f = fopen(edgesPath, "w");
+    assert(f);
+    for (const cyber::CSREdge& e : scaleFree)
+        fprintf(f, "%u %u\n", e.source, e.target);
+    fclose(f);
+    ok = cyber::CSRGraphFile::ConvertEdgeList(edgesPath, graphPath, true);
+    assert(ok);
+    cyber::CSRGraph undirected;
+    undirected.BuildFromEdges(2000, scaleFree.data(), scaleFree.size(), true);
+    ok = file.Open(graphPath);
+    assert(ok && SameGraph(file.View(), undirected));
+    file.Close();
+
+    // weights that would wrap or hit invalid_cost and negative node ids are rejected like bad node ids
+    const char* badLines[] = { "0 1 4294967296\n", "0 1 4294967295\n", "0 1 99999999999999999999999\n", "0 1 -1\n", "-1 1 2\n", "0 4294967295\n" };
+    for (const char* badLine : badLines)
+    {
+        f = fopen(edgesPath, "w");
+        assert(f);
+        fprintf(f, "0 1 3\n%s", badLine);
+        fclose(f);
+        ok = cyber::CSRGraphFile::ConvertEdgeList(edgesPath, graphPath);
+        assert(!ok);
+    }
+
+    std::remove(graphPath);
+    std::remove(edgesPath);
+}
+
+// reachability of every pair against the index, exact for undirected graphs and strong components
+static void CheckConnectivity(const cyber::ConnectivityIndex& index, const std::vector<cyber::CSREdge>& edges, uint32_t nodeCount, bool undirected)
+{
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(nodeCount, edges.data(), edges.size(), undirected);
+    std::vector<std::vector<uint32_t>> depths(nodeCount);
+    for (uint32_t s = 0; s < nodeCount; ++s)
+        depths[s] = ReferenceDepths(graph, s);
+
+    uint32_t components = 0;
+    for (uint32_t s = 0; s < nodeCount; ++s)
+    {
+        // counts each component at its lowest id
+        uint32_t lowest = s;
+        for (uint32_t t = 0; t < s && lowest == s; ++t)
+        {
+            if (depths[s][t] != cyber::invalid_node_id && depths[t][s] != cyber::invalid_node_id)
+                lowest = t;
+        }
+        components += lowest == s ? 1 : 0;
+
+        for (uint32_t t = 0; t < nodeCount; ++t)
+        {
+            bool reach = depths[s][t] != cyber::invalid_node_id;
+            bool mutual = reach && depths[t][s] != cyber::invalid_node_id;
+            assert(!reach || index.MayReach(s, t));
+            assert(!undirected || index.MayReach(s, t) == reach);
+            assert(index.SameComponent(s, t) == mutual);
+        }
+    }
+    assert(index.ComponentCount() == components);
+}
+
+static std::vector<cyber::CSREdge> RandomEdges(uint32_t nodeCount, uint32_t edgeCount, uint32_t seed)
+{
+    std::vector<cyber::CSREdge> edges;
+    for (uint32_t i = 0; i < edgeCount; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t a = (seed >> 8) % nodeCount;
+        seed = seed * 1664525u + 1013904223u;
+        edges.push_back({ a, (seed >> 8) % nodeCount });
+    }
+    return edges;
+}
+
+void connectivitytest()
+{
+    const uint32_t n = 300;
+    std::vector<cyber::CSREdge> edges = RandomEdges(n, 700, 13);
+
+    // sparse enough to leave many components, then edges arrive one by one
+    for (int undirected = 1; undirected >= 0; --undirected)
+    {
+        std::vector<cyber::CSREdge> current(edges.begin(), edges.begin() + 100);
+        cyber::CSRGraph graph;
+        graph.BuildFromEdges(n, current.data(), current.size(), undirected != 0);
+        cyber::ConnectivityIndex index;
+        index.Build(graph, undirected != 0);
+        assert(index.IsUndirected() == (undirected != 0));
+        CheckConnectivity(index, current, n, undirected != 0);
+
+        for (size_t i = 100; i < edges.size(); ++i)
+        {
+            index.AddEdge(edges[i].source, edges[i].target);
+            current.push_back(edges[i]);
+            if (i % 50 == 49)
+                CheckConnectivity(index, current, n, undirected != 0);
+        }
+        CheckConnectivity(index, current, n, undirected != 0);
+    }
+
+    // long cycle closed by the last edge merges every strong component at once
+    std::vector<cyber::CSREdge> chain;
+    for (uint32_t v = 0; v + 1 < 50; ++v)
+        chain.push_back({ v, v + 1 });
+    cyber::CSRGraph chainGraph;
+    chainGraph.BuildFromEdges(50, chain.data(), chain.size());
+    cyber::ConnectivityIndex chainIndex;
+    chainIndex.Build(chainGraph, false);
+    assert(chainIndex.ComponentCount() == 50 && chainIndex.MayReach(0, 49) && !chainIndex.MayReach(49, 0));
+    chainIndex.AddEdge(49, 0);
+    chain.push_back({ 49, 0 });
+    CheckConnectivity(chainIndex, chain, 50, false);
+    assert(chainIndex.ComponentCount() == 1);
+
+    // searches reject without exploring and still find every reachable pair
+    std::vector<cyber::CSREdge> sparse = RandomEdges(2000, 1500, 3);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(2000, sparse.data(), sparse.size(), true);
+    cyber::ConnectivityIndex index;
+    index.Build(graph, true);
+
+    cyber::BreadthFirstSearch bfs;
+    cyber::BidirectionalBFS bidirectional;
+    cyber::DijkstraSearch dijkstra;
+    bfs.SetConnectivityIndex(&index);
+    bidirectional.SetConnectivityIndex(&index);
+    dijkstra.SetConnectivityIndex(&index);
+    uint32_t rejected = 0;
+    for (uint32_t q = 0; q < 200; ++q)
+    {
+        uint32_t s = (q * 7919) % 2000, t = (q * 104729 + 17) % 2000;
+        std::vector<uint32_t> depths = ReferenceDepths(graph, s);
+        bool reach = depths[t] != cyber::invalid_node_id;
+        assert((bfs.FindPathReversed(graph, s, t) != nullptr) == reach);
+        assert((bidirectional.FindPathReversed(graph, graph, s, t) != nullptr) == reach);
+        assert((dijkstra.FindPathReversed(graph, s, t) != nullptr) == reach);
+        if (!reach)
+        {
+            assert(bidirectional.ExploredNodes() == 0 && dijkstra.SettledNodes() == 0);
+            ++rejected;
+        }
+    }
+    assert(rejected > 0);
+}
+
+// distances match a search from the goal and every next hop follows an edge that keeps the path cheapest
+static void CheckFlowField(const cyber::FlowField& field, const cyber::CSRGraphView& graph, const cyber::CSRGraphView& reverse)
+{
+    std::vector<uint32_t> expected = ReferenceCosts(reverse, field.Goal());
+    assert(field.Distances() == expected);
+    assert(field.NextHop(field.Goal()) == field.Goal());
+    for (uint32_t v = 0; v < graph.node_count; ++v)
+    {
+        uint32_t next = field.NextHop(v);
+        if (expected[v] == cyber::FlowField::invalid_cost)
+        {
+            assert(next == cyber::invalid_node_id);
+            continue;
+        }
+        if (v == field.Goal())
+            continue;
+
+        uint32_t best = 0xFFFFFFFF;
+        for (uint32_t e = graph.offsets[v]; e != graph.offsets[v + 1]; ++e)
+            best = graph.targets[e] == next && graph.Weight(e) < best ? graph.Weight(e) : best;
+        assert(best != 0xFFFFFFFF && best + expected[next] == expected[v]);
+    }
+}
+
+void flowfieldtest()
+{
+    // weighted 8-connected grid, the goal walks around and the field is repaired
+    cyber::GridMap grid;
+    RandomGrid(grid, 64, 48, 60, 31);
+    cyber::CSRGraph gridGraph, gridReverse;
+    GridGraph(grid, gridGraph);
+    gridReverse.BuildTranspose(gridGraph);
+
+    uint32_t goal = 0;
+    while (grid.IsBlocked(int32_t(grid.CellX(goal)), int32_t(grid.CellY(goal))))
+        ++goal;
+    cyber::FlowField field;
+    field.Build(gridReverse, goal);
+    CheckFlowField(field, gridGraph, gridReverse);
+
+    // agents walk the next hops to the goal
+    for (uint32_t v = 0; v < gridGraph.NodeCount(); v += 97)
+    {
+        uint32_t steps = 0;
+        for (uint32_t cur = v; field.Distance(cur) != cyber::FlowField::invalid_cost && cur != goal; cur = field.NextHop(cur))
+            ++steps;
+        assert(steps < gridGraph.NodeCount());
+    }
+
+    uint32_t repaired = 0;
+    for (uint32_t step = 0; step < 40; ++step)
+    {
+        // next goal is a random neighbor of the current one
+        const uint32_t* begin = gridGraph.View().NeighborsBegin(goal);
+        uint32_t degree = gridGraph.View().Degree(goal);
+        if (degree == 0)
+            break;
+        goal = begin[(step * 7 + 3) % degree];
+        repaired += field.MoveGoal(gridReverse, goal) ? 1 : 0;
+        assert(field.Goal() == goal);
+        CheckFlowField(field, gridGraph, gridReverse);
+    }
+    assert(repaired > 0);
+
+    // a far jump exceeding the bucket budget falls back to a rebuild
+    field.max_buckets = 16;
+    uint32_t far = gridGraph.NodeCount() - 1;
+    while (field.Distance(far) == cyber::FlowField::invalid_cost || field.Distance(far) < 16 * 1000)
+        --far;
+    bool ok = field.MoveGoal(gridReverse, far);
+    assert(!ok);
+    CheckFlowField(field, gridGraph, gridReverse);
+
+    // directed weighted graph with unreachable parts
+    std::vector<cyber::CSREdge> scaleFree = ScaleFreeEdges(3000, 4000, 41);
+    std::vector<cyber::CSRWeightedEdge> weighted;
+    for (const cyber::CSREdge& e : scaleFree)
+        weighted.push_back({ e.source, e.target, 1 + (e.source + 3 * e.target) % 9 });
+    cyber::CSRGraph directed, directedReverse;
+    directed.BuildFromEdges(3000, weighted.data(), weighted.size());
+    directedReverse.BuildTranspose(directed);
+    field.max_buckets = 1 << 16;
+    field.Build(directedReverse, 0);
+    CheckFlowField(field, directed, directedReverse);
+    for (uint32_t g = 1; g < 3000; g += 311)
+    {
+        field.MoveGoal(directedReverse, g);
+        CheckFlowField(field, directed, directedReverse);
+    }
+
+    // parallel build on an unweighted graph
+    std::vector<cyber::CSREdge> plain = ScaleFreeEdges(20000, 60000, 43);
+    cyber::CSRGraph plainGraph, plainReverse;
+    plainGraph.BuildFromEdges(20000, plain.data(), plain.size());
+    plainReverse.BuildTranspose(plainGraph);
+    cyber::ParallelBFS bfs(4);
+    cyber::FlowField serial;
+    serial.Build(plainReverse, 5);
+    CheckFlowField(serial, plainGraph, plainReverse);
+    field.Build(bfs, plainReverse, 5);
+    assert(field.Distances() == serial.Distances());
+    CheckFlowField(field, plainGraph, plainReverse);
+    field.MoveGoal(plainReverse, plainGraph.View().Degree(5) ? *plainGraph.View().NeighborsBegin(5) : 5);
+    CheckFlowField(field, plainGraph, plainReverse);
+}
+
+void pathqueryservicetest()
+{
+    std::vector<cyber::CSREdge> edges = ScaleFreeEdges(4000, 5000, 17);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(4000, edges.data(), edges.size(), true);
+    cyber::ConnectivityIndex index;
+    index.Build(graph, true);
+
+    // a few hot pairs so submissions repeat
+    auto pairOf = [](uint32_t i) { return std::make_pair((i * 37) % 4000, (i * 101 + 7) % 4000); };
+    auto check = [&](uint32_t i, const std::vector<uint32_t>& path)
+    {
+        std::pair<uint32_t, uint32_t> q = pairOf(i);
+        uint32_t depth = ReferenceDepths(graph, q.first)[q.second];
+        if (depth == cyber::invalid_node_id)
+        {
+            assert(path.empty());
+            return;
+        }
+        assert(path.size() == size_t(depth) + 1 && path.front() == q.second && path.back() == q.first);
+    };
+
+    std::atomic<uint32_t> callbacks{ 0 };
+    {
+        cyber::PathQueryService service(graph, 3);
+        assert(service.ThreadCount() == 3);
+        service.SetConnectivityIndex(&index);
+
+        // identical requests share one search
+        std::vector<std::future<std::vector<uint32_t>>> same;
+        for (int i = 0; i < 10; ++i)
+            same.push_back(service.Submit(pairOf(1).first, pairOf(1).second));
+        same.push_back(service.Submit(pairOf(2).first, pairOf(2).second));
+        size_t started = service.Tick();
+        assert(started == 11 && service.LastBatchSearches() == 2);
+        service.Flush();
+        for (int i = 0; i < 10; ++i)
+            check(1, same[i].get());
+        check(2, same[10].get());
+
+        // submitters on several threads while this thread ticks
+        const uint32_t perThread = 300;
+        std::vector<std::vector<std::future<std::vector<uint32_t>>>> results(4);
+        std::atomic<uint32_t> submitted{ 0 };
+        std::vector<std::thread> submitters;
+        for (uint32_t t = 0; t < 4; ++t)
+        {
+            submitters.emplace_back([&, t]
+            {
+                for (uint32_t k = 0; k < perThread; ++k)
+                {
+                    uint32_t i = (t * perThread + k) % 97;
+                    std::pair<uint32_t, uint32_t> q = pairOf(i);
+                    if (k % 3 == 0)
+                    {
+                        service.Submit(q.first, q.second, [&, i](const std::vector<uint32_t>* path)
+                        {
+                            check(i, path ? *path : std::vector<uint32_t>());
+                            callbacks.fetch_add(1);
+                        });
+                    }
+                    else
+                    {
+                        results[t].push_back(service.Submit(q.first, q.second));
+                    }
+                    submitted.fetch_add(1);
+                }
+            });
+        }
+
+        size_t total = 0;
+        while (submitted.load() < 4 * perThread)
+            total += service.Tick();
+        for (std::thread& t : submitters)
+            t.join();
+        service.Flush();
+        assert(total <= 4 * perThread);
+
+        for (uint32_t t = 0; t < 4; ++t)
+        {
+            uint32_t k = 0;
+            for (std::future<std::vector<uint32_t>>& f : results[t])
+            {
+                while (k % 3 == 0)
+                    ++k;
+                check((t * perThread + k) % 97, f.get());
+                ++k;
+            }
+        }
+        assert(callbacks.load() == 4 * perThread / 3);
+
+        // the destructor completes requests that were never ticked
+        for (uint32_t i = 0; i < 20; ++i)
+        {
+            std::pair<uint32_t, uint32_t> q = pairOf(i);
+            service.Submit(q.first, q.second, [&, i](const std::vector<uint32_t>* path)
+            {
+                check(i, path ? *path : std::vector<uint32_t>());
+                callbacks.fetch_add(1);
+            });
+        }
+    }
+    assert(callbacks.load() == 4 * 300 / 3 + 20);
+}
+
+// path from goal back to start over existing edges with the shortest hop count
+static void CheckCachedPath(const cyber::CSRGraphView& graph, const uint32_t* path, uint32_t length, uint32_t start, uint32_t goal)
+{
+    uint32_t depth = ReferenceDepths(graph, start)[goal];
+    assert(path && length == depth + 1 && path[0] == goal && path[length - 1] == start);
+    for (uint32_t i = 0; i + 1 < length; ++i)
+        assert(std::find(graph.NeighborsBegin(path[i + 1]), graph.NeighborsEnd(path[i + 1]), path[i]) != graph.NeighborsEnd(path[i + 1]));
+}
+
+void pathcachetest()
+{
+    std::vector<cyber::CSREdge> edges = GridEdges(32, 32);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(32 * 32, edges.data(), edges.size(), true);
+    cyber::BreadthFirstSearch bfs;
+    cyber::PathCache cache;
+    uint32_t length;
+
+    // whole path, then the same query, then a suffix of it
+    const uint32_t* path = cache.FindPathReversed(bfs, graph, 0, 32 * 32 - 1, 0, length);
+    CheckCachedPath(graph, path, length, 0, 32 * 32 - 1);
+    assert(cache.Misses() == 1 && cache.PathCount() == 1);
+    path = cache.FindPathReversed(bfs, graph, 0, 32 * 32 - 1, 0, length);
+    CheckCachedPath(graph, path, length, 0, 32 * 32 - 1);
+    assert(cache.Hits() == 1);
+    uint32_t middle = path[length / 2];
+    path = cache.Find(middle, 32 * 32 - 1, 0, length);
+    CheckCachedPath(graph, path, length, middle, 32 * 32 - 1);
+    assert(cache.SuffixHits() == 1);
+
+    // other versions miss
+    path = cache.Find(0, 32 * 32 - 1, 1, length);
+    assert(!path && length == 0 && cache.PathCount() == 0);
+
+    // repeated random queries, every answer is a shortest path
+    uint32_t seed = 5;
+    for (uint32_t q = 0; q < 600; ++q)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t start = (seed >> 8) % 40, goal = 1000 + (seed >> 20) % 24;
+        path = cache.FindPathReversed(bfs, graph, start, goal, 0, length);
+        CheckCachedPath(graph, path, length, start, goal);
+    }
+    assert(cache.Hits() + cache.SuffixHits() > 300);
+
+    // removing an edge drops only the paths over it
+    uint32_t crossing = 0, kept = 0;
+    std::vector<std::pair<uint32_t, uint32_t>> cached;
+    for (uint32_t start = 0; start < 40; ++start)
+    {
+        for (uint32_t goal = 1000; goal < 1024; ++goal)
+        {
+            if (cache.Find(start, goal, 0, length))
+                cached.push_back({ start, goal });
+        }
+    }
+    cyber::CSREdge cut = { 1000 - 32, 1000 };
+    std::vector<cyber::CSREdge> remaining;
+    for (const cyber::CSREdge& e : edges)
+    {
+        if (!(e.source == cut.source && e.target == cut.target) && !(e.source == cut.target && e.target == cut.source))
+            remaining.push_back(e);
+    }
+    cyber::CSRGraph edited;
+    edited.BuildFromEdges(32 * 32, remaining.data(), remaining.size(), true);
+    cache.InvalidateEdges(&cut, 1, 0, 1);
+    for (const std::pair<uint32_t, uint32_t>& q : cached)
+    {
+        path = cache.Find(q.first, q.second, 1, length);
+        if (path)
+        {
+            CheckCachedPath(edited, path, length, q.first, q.second);
+            ++kept;
+        }
+        else
+        {
+            ++crossing;
+        }
+        path = cache.FindPathReversed(bfs, edited, q.first, q.second, 1, length);
+        CheckCachedPath(edited, path, length, q.first, q.second);
+    }
+    assert(kept > 0 && crossing > 0);
+
+    // least recently used paths go first, and the arena compacts under pressure
+    cyber::PathCache small(4, 300);
+    for (uint32_t start = 0; start < 5; ++start)
+        small.FindPathReversed(bfs, graph, start * 32, 1023 - start, 0, length);
+    assert(small.PathCount() == 4 && small.ArenaNodes() <= 300);
+    assert(!small.Find(0, 1023, 0, length));
+    for (uint32_t round = 0; round < 50; ++round)
+    {
+        uint32_t start = (round * 97) % 1024, goal = (round * 389 + 11) % 1024;
+        path = small.FindPathReversed(bfs, graph, start, goal, 0, length);
+        CheckCachedPath(graph, path, length, start, goal);
+        assert(small.ArenaNodes() <= 300 && small.PathCount() <= 4);
+    }
+    for (uint32_t start = 0; start < 1024; start += 13)
+    {
+        for (uint32_t goal = 0; goal < 1024; goal += 17)
+        {
+            path = small.Find(start, goal, 0, length);
+            if (path)
+                CheckCachedPath(graph, path, length, start, goal);
+        }
+    }
+}
+
+// bounds never exceed real costs, never drop by more than an edge, and A* with them matches Dijkstra
+static uint64_t CheckLandmarks(const cyber::LandmarkIndex& index, const cyber::CSRGraphView& graph, uint32_t targetStep)
+{
+    cyber::DijkstraSearch dijkstra;
+    cyber::ShortestPathSearch<cyber::IndexedDaryHeap<4>> astar;
+    cyber::ShortestPathSearch<cyber::RadixHeap> radixAstar;
+    uint64_t plainSettled = 0, landmarkSettled = 0;
+    for (uint32_t target = 0; target < graph.node_count; target += targetStep)
+    {
+        cyber::CSRGraph reverse;
+        reverse.BuildTranspose(graph);
+        std::vector<uint32_t> toTarget = ReferenceCosts(reverse, target);
+        for (uint32_t v = 0; v < graph.node_count; ++v)
+        {
+            uint32_t h = index.LowerBound(v, target);
+            assert(toTarget[v] == 0xFFFFFFFF || h <= toTarget[v]);
+            for (uint32_t e = graph.offsets[v]; e != graph.offsets[v + 1]; ++e)
+                assert(h <= graph.Weight(e) + index.LowerBound(graph.targets[e], target));
+        }
+        assert(index.LowerBound(target, target) == 0);
+
+        for (uint32_t start = 1; start < graph.node_count; start += 97)
+        {
+            const std::vector<uint32_t>* path = dijkstra.FindPathReversed(graph, start, target);
+            plainSettled += dijkstra.SettledNodes();
+            assert((path != nullptr) == (toTarget[start] != 0xFFFFFFFF));
+
+            path = astar.FindPathReversed(graph, start, target, index.Heuristic(target));
+            landmarkSettled += astar.SettledNodes();
+            assert(path ? astar.PathCost() == toTarget[start] : toTarget[start] == 0xFFFFFFFF);
+
+            path = radixAstar.FindPathReversed(graph, start, target, index.Heuristic(target));
+            assert(path ? radixAstar.PathCost() == toTarget[start] : toTarget[start] == 0xFFFFFFFF);
+        }
+    }
+    assert(landmarkSettled <= plainSettled);
+    return plainSettled - landmarkSettled;
+}
+
+void landmarktest()
+{
+    // road-like weighted grid
+    std::vector<cyber::CSREdge> grid = GridEdges(60, 60);
+    std::vector<cyber::CSRWeightedEdge> roads;
+    for (const cyber::CSREdge& e : grid)
+        roads.push_back({ e.source, e.target, 1 + (e.source * 13 + e.target * 7) % 20 });
+    cyber::CSRGraph roadGraph;
+    roadGraph.BuildFromEdges(3600, roads.data(), roads.size(), true);
+
+    cyber::LandmarkIndex index;
+    index.Build(roadGraph, roadGraph, 8);
+    assert(index.LandmarkCount() == 8 && index.IsCompact());
+    assert(index.MemoryBytes() < 3600 * 8 * 2 * 4);
+
+    // farthest first spreads the landmarks, the first ones land in corners
+    std::vector<uint32_t> corners = { 0, 59, 3540, 3599 };
+    assert(std::find(corners.begin(), corners.end(), index.Landmarks()[0]) != corners.end());
+    std::vector<uint32_t> sorted = index.Landmarks();
+    std::sort(sorted.begin(), sorted.end());
+    assert(std::unique(sorted.begin(), sorted.end()) == sorted.end());
+
+    uint64_t saved = CheckLandmarks(index, roadGraph, 599);
+    assert(saved > 0);
+
+    // directed, with nodes that cannot reach each other, and distances too long for 16 bits
+    std::vector<cyber::CSREdge> scaleFree = ScaleFreeEdges(1500, 2500, 23);
+    std::vector<cyber::CSRWeightedEdge> weighted;
+    for (const cyber::CSREdge& e : scaleFree)
+        weighted.push_back({ e.source, e.target, 20000 + (e.source ^ e.target) % 50000 });
+    cyber::CSRGraph directed, reverse;
+    directed.BuildFromEdges(1500, weighted.data(), weighted.size());
+    reverse.BuildTranspose(directed);
+    index.Build(directed, reverse, 6, 3);
+    assert(index.LandmarkCount() == 6 && !index.IsCompact());
+    CheckLandmarks(index, directed, 211);
+
+    // no landmarks, no bound
+    index.Build(directed, reverse, 0);
+    assert(index.LandmarkCount() == 0 && index.LowerBound(3, 4) == 0);
+}
+
+// neighbor lists of a dynamic graph against a plain model, in order
+static void CheckDynamic(const cyber::DynamicGraph& graph, const std::vector<std::vector<std::pair<uint32_t, uint32_t>>>& model)
+{
+    uint32_t edgeCount = 0;
+    for (uint32_t v = 0; v < graph.NodeCount(); ++v)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        graph.ForEachEdge(v, [&](uint32_t target, uint32_t weight) { edges.push_back({ target, weight }); });
+        assert(edges == model[v] && graph.Degree(v) == model[v].size());
+        edgeCount += uint32_t(edges.size());
+    }
+    assert(graph.EdgeCount() == edgeCount);
+}
+
+void dynamicgraphtest()
+{
+    const uint32_t n = 900;
+    std::vector<cyber::CSREdge> edges = GridEdges(30, 30);
+    cyber::CSRGraph initial;
+    initial.BuildFromEdges(n, edges.data(), edges.size(), true);
+
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> model(n);
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        for (const uint32_t* itr = initial.View().NeighborsBegin(v); itr != initial.View().NeighborsEnd(v); ++itr)
+            model[v].push_back({ *itr, 1 });
+    }
+
+    cyber::DynamicGraph graph;
+    graph.merge_threshold = 64;
+    graph.Reset(initial);
+    CheckDynamic(graph, model);
+
+    cyber::BreadthFirstSearch bfs;
+    uint32_t merges = 0, seed = 77;
+    for (uint32_t step = 0; step < 3000; ++step)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t a = (seed >> 8) % n;
+        seed = seed * 1664525u + 1013904223u;
+        uint32_t b = (seed >> 8) % n;
+        uint32_t version = graph.Version();
+        if ((seed >> 4) % 3 == 0)
+        {
+            // removals pick an existing edge most of the time
+            if (!model[a].empty() && (seed >> 12) % 4 != 0)
+                b = model[a][(seed >> 14) % model[a].size()].first;
+            auto itr = std::find_if(model[a].begin(), model[a].end(), [&](const std::pair<uint32_t, uint32_t>& e) { return e.first == b; });
+            bool removed = graph.RemoveEdge(a, b);
+            assert(removed == (itr != model[a].end()));
+            assert(graph.Version() == (removed ? version + 1 : version));
+            if (itr != model[a].end())
+                model[a].erase(itr);
+        }
+        else
+        {
+            uint32_t weight = step % 5 == 0 ? 3 : 1;
+            graph.InsertEdge(a, b, weight);
+            model[a].push_back({ b, weight });
+            assert(graph.Version() == version + 1);
+        }
+
+        // merges finish in the background while edits continue, and never change the version
+        version = graph.Version();
+        merges += graph.Maintain() ? 1 : 0;
+        if (step % 500 == 499)
+            merges += graph.FinishMerge(true) ? 1 : 0;
+        assert(graph.Version() == version);
+
+        if (step % 100 == 0)
+        {
+            CheckDynamic(graph, model);
+
+            std::vector<cyber::CSREdge> current;
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                for (const std::pair<uint32_t, uint32_t>& e : model[v])
+                    current.push_back({ v, e.first });
+            }
+            cyber::CSRGraph snapshot;
+            snapshot.BuildFromEdges(n, current.data(), current.size());
+            std::vector<uint32_t> depths = ReferenceDepths(snapshot, a);
+            for (uint32_t end = 0; end < n; end += 37)
+            {
+                const std::vector<uint32_t>* path = bfs.FindPathReversed(graph, a, end);
+                assert(path ? path->size() == size_t(depths[end]) + 1 : depths[end] == cyber::invalid_node_id);
+            }
+        }
+    }
+    graph.FinishMerge(true);
+    CheckDynamic(graph, model);
+    assert(merges > 0 && !graph.MergeInProgress());
+
+    // merging everything leaves the base equal to the model
+    graph.StartMerge();
+    graph.FinishMerge(true);
+    assert(graph.PendingEdits() == 0 && !graph.Base().weights.empty());
+    CheckDynamic(graph, model);
+}
+
+void forwardpathtest()
+{
+    std::vector<cyber::CSREdge> edges = ScaleFreeEdges(2000, 3000, 11);
+    cyber::CSRGraph graph;
+    graph.BuildFromEdges(2000, edges.data(), edges.size(), true);
+
+    cyber::BreadthFirstSearch bfs, reference;
+    std::vector<uint32_t> arena(64 * 2000);
+    size_t used = 0;
+    std::vector<std::pair<size_t, uint32_t>> stored;
+    for (uint32_t start = 0; start < 2000; start += 31)
+    {
+        for (uint32_t end = 1; end < 2000; end += 97)
+        {
+            // arena users pass the free tail and only advance when the path fit
+            uint32_t length = bfs.FindPath(graph, start, end, arena.data() + used, uint32_t(arena.size() - used));
+            const std::vector<uint32_t>* path = reference.FindPathReversed(graph, start, end);
+            assert(length == (path ? path->size() : 0));
+            if (length == 0 || used + length > arena.size())
+                continue;
+            assert(std::equal(path->rbegin(), path->rend(), arena.begin() + used));
+            stored.push_back({ used, length });
+            used += length;
+        }
+    }
+    assert(stored.size() > 100);
+
+    // earlier paths stay intact since the search never touches the caller's buffer
+    for (const std::pair<size_t, uint32_t>& s : stored)
+    {
+        const uint32_t* path = arena.data() + s.first;
+        for (uint32_t i = 0; i + 1 < s.second; ++i)
+            assert(std::find(graph.View().NeighborsBegin(path[i]), graph.View().NeighborsEnd(path[i]), path[i + 1]) != graph.View().NeighborsEnd(path[i]));
+    }
+
+    // too small a buffer reports the length, writes nothing and the last path can be written without a search
+    cyber::CSRGraph grid;
+    std::vector<cyber::CSREdge> gridEdges = GridEdges(16, 16);
+    grid.BuildFromEdges(256, gridEdges.data(), gridEdges.size(), true);
+    uint32_t small[8] = { 7, 7, 7, 7, 7, 7, 7, 7 };
+    assert(bfs.FindPath(grid, 0, 255, small, 8) == 31);
+    assert(std::count(small, small + 8, 7u) == 8);
+    std::vector<uint32_t> large(31);
+    assert(bfs.WriteLastPath(large.data(), 31) == 31 && large.front() == 0 && large.back() == 255);
+    assert(bfs.FindPath(grid, 5, 5, small, 8) == 1 && small[0] == 5);
+
+    // no path, also when the connectivity index rejects the query
+    cyber::CSREdge chain[] = { { 0, 1 }, { 1, 2 } };
+    cyber::CSRGraph directed;
+    directed.BuildFromEdges(3, chain, 2);
+    assert(bfs.FindPath(directed, 2, 0, small, 8) == 0 && bfs.WriteLastPath(small, 8) == 0);
+    cyber::ConnectivityIndex index;
+    index.Build(directed, false);
+    bfs.SetConnectivityIndex(&index);
+    assert(bfs.FindPath(directed, 0, 2, small, 8) == 3 && small[0] == 0 && small[2] == 2);
+    assert(bfs.FindPath(directed, 2, 0, small, 8) == 0);
+    bfs.SetConnectivityIndex(nullptr);
+
+    // dynamic graphs, an inserted shortcut shows up in the next query
+    cyber::DynamicGraph dynamic;
+    dynamic.Reset(grid);
+    assert(bfs.FindPath(dynamic, 0, 255, large.data(), 31) == 31);
+    dynamic.InsertEdge(0, 255);
+    assert(bfs.FindPath(dynamic, 0, 255, small, 8) == 2 && small[0] == 0 && small[1] == 255);
+
+    // BFSNode graphs as node pointers or compact ids
+    std::vector<cyber::BFSNode> nodes(256);
+    for (uint32_t v = 0; v < 256; ++v)
+    {
+        nodes[v].id = v;
+        for (const uint32_t* itr = grid.View().NeighborsBegin(v); itr != grid.View().NeighborsEnd(v); ++itr)
+            nodes[v].neighbors.push_back(&nodes[*itr]);
+    }
+    std::vector<cyber::BFSNode*> nodePath(31);
+    assert(bfs.FindPath(&nodes[0], &nodes[255], nodePath.data(), 4) == 31);
+    assert(bfs.WriteLastPath(nodePath.data(), 31) == 31 && nodePath.front() == &nodes[0] && nodePath.back() == &nodes[255]);
+    const std::vector<cyber::BFSNode*>* reversed = reference.FindPathReversed(&nodes[0], &nodes[255]);
+    assert(reversed && std::equal(reversed->rbegin(), reversed->rend(), nodePath.begin()));
+    assert(bfs.FindPath(&nodes[0], &nodes[255], large.data(), 31) == 31);
+    for (uint32_t i = 0; i < 31; ++i)
+        assert(large[i] == nodePath[i]->id);
+    nodes[255].neighbors.clear();
+    nodes[254].neighbors.clear();
+    nodes[239].neighbors.clear();
+    for (cyber::BFSNode& n : nodes)
+        n.neighbors.erase(std::remove(n.neighbors.begin(), n.neighbors.end(), &nodes[255]), n.neighbors.end());
+    assert(bfs.FindPath(&nodes[0], &nodes[255], nodePath.data(), 31) == 0);
+}
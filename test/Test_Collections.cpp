@@ -0,0 +1,182 @@
+#include "SparseSet.hpp"
+#include "BTree.hpp"
+#include "Relocate.hpp"
+#include "Intrusive.hpp"
+#include "CompressedIntSequence.hpp"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <assert.h>
+
+struct OwnedBuffer
+{
+    int* p = nullptr;
+    OwnedBuffer() = default;
+    OwnedBuffer(OwnedBuffer&& o) noexcept : p(o.p) { o.p = nullptr; }
+    ~OwnedBuffer() { delete p; }
+};
+CX_TRIVIALLY_RELOCATABLE(OwnedBuffer)
+
+
+void sparsesettest()
+{
+    cyber::SparseIdSet<> tags;
+    cyber::SparseSet<float> speeds;
+
+    bool inserted = tags.insert(3);
+    bool reinserted = tags.insert(3);
+    assert(inserted && !reinserted);
+    tags.insert(70000); // lazily allocates a distant page
+    tags.insert(12);
+
+    speeds.emplace(12, 1.0f);
+    speeds.emplace(3, 2.0f);
+    speeds.emplace(5, 3.0f);
+    speeds.emplace(12, 4.0f); // assigns existing
+
+    assert(tags.contains(70000) && !tags.contains(69999));
+    assert(speeds.size() == 3 && speeds[12] == 4.0f);
+
+    std::vector<uint32_t> both;
+    cyber::ForEachIntersection({ &tags, &speeds }, [&](uint32_t id) { both.push_back(id); });
+    assert(both.size() == 2);
+
+    bool erased = speeds.erase(3);
+    bool reerased = speeds.erase(3);
+    assert(erased && !reerased);
+    assert(speeds.find(3) == nullptr);
+    assert(*speeds.find(5) == 3.0f && *speeds.find(12) == 4.0f);
+
+    tags.clear();
+    assert(tags.empty() && !tags.contains(12));
+}
+
+void btreetest()
+{
+    cyber::BTreeMap<uint32_t, uint32_t> timestamps;
+
+    // enough keys for several inner levels
+    for (uint32_t i = 0; i < 100000; ++i)
+        timestamps.insert((i * 7919u) % 100000u, i);
+    assert(timestamps.size() == 100000);
+    bool inserted = timestamps.insert(42, 0).second;
+    assert(!inserted);
+
+    uint32_t prev = 0, scanned = 0;
+    timestamps.for_each_range(500, 1500, [&](uint32_t key, uint32_t) { assert(scanned == 0 || key > prev); prev = key; ++scanned; });
+    assert(scanned == 1000);
+
+    size_t erased = 0;
+    for (uint32_t i = 0; i < 100000; i += 2)
+        erased += timestamps.erase(i);
+    assert(erased == 50000 && timestamps.size() == 50000 && !timestamps.contains(10) && timestamps.contains(11));
+    assert(timestamps.lower_bound(10).key() == 11);
+    assert(timestamps.begin().key() == 1 && timestamps.last().key() == 99999);
+
+    // priority queue with removal
+    cyber::BTreeSet<float> queue;
+    queue.insert(3.0f);
+    queue.insert(1.0f);
+    queue.insert(2.0f);
+    queue.erase(queue.begin());
+    assert(queue.begin().key() == 2.0f && queue.size() == 2);
+}
+
+void relocatetest()
+{
+    static_assert(cyber::is_trivially_relocatable_v<OwnedBuffer>, "opt-in");
+    static_assert(!cyber::is_trivially_relocatable_v<std::string>, "default");
+
+    // erase-shift of a non-trivial type moves element by element
+    alignas(std::string) unsigned char bytes[sizeof(std::string) * 3];
+    std::string* strs = reinterpret_cast<std::string*>(bytes);
+    new(strs + 0) std::string(40, 'a');
+    new(strs + 1) std::string(40, 'b');
+    new(strs + 2) std::string(40, 'c');
+    strs[0].~basic_string();
+    cyber::relocate(strs, strs + 1, 2);
+    assert(strs[0][0] == 'b' && strs[1][0] == 'c');
+    cyber::destroy(strs, 2);
+}
+
+struct Timer
+{
+    uint64_t deadline;
+    uint32_t id;
+    cyber::IntrusiveListHook lru;
+    cyber::IntrusiveHashHook by_id;
+    cyber::IntrusiveHeapHook by_deadline;
+
+    Timer(uint64_t deadline, uint32_t id) : deadline(deadline), id(id) {}
+
+    struct Id { uint32_t operator()(const Timer& t) const { return t.id; } };
+    bool operator<(const Timer& rhs) const { return deadline < rhs.deadline; }
+};
+
+void intrusivetest()
+{
+    cyber::StaticPoolAllocator<Timer> pool;
+    cyber::IntrusiveList<Timer, &Timer::lru> lru;
+    cyber::IntrusiveHashSet<Timer, &Timer::by_id, Timer::Id> ids;
+    cyber::IntrusiveHeap<Timer, &Timer::by_deadline> deadlines;
+
+    Timer* timers[100];
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        timers[i] = new(pool.allocate(1)) Timer((i * 37u) % 100u, i);
+        lru.push_back(*timers[i]);
+        ids.insert(*timers[i]);
+        deadlines.push(*timers[i]);
+    }
+    assert(lru.size() == 100 && ids.size() == 100 && deadlines.size() == 100);
+
+    lru.move_to_front(*timers[50]);
+    assert(lru.front().id == 50 && lru.back().id == 99);
+    assert(ids.find(42) == timers[42] && ids.find(1000) == nullptr);
+    assert(deadlines.top().deadline == 0);
+
+    // reschedule, then drop from every container before returning to the pool
+    timers[0]->deadline = 500;
+    deadlines.update(*timers[0]);
+    assert(deadlines.top().deadline == 1);
+
+    Timer& expired = deadlines.pop();
+    lru.erase(expired);
+    ids.erase(expired);
+    pool.deallocate(&expired, 1);
+
+    uint64_t prev = 0;
+    while (!deadlines.empty())
+    {
+        Timer& t = deadlines.pop();
+        assert(t.deadline >= prev);
+        prev = t.deadline;
+        lru.erase(t);
+        ids.erase(t);
+        pool.deallocate(&t, 1);
+    }
+    assert(lru.empty() && ids.empty());
+}
+
+void compressedsequencetest()
+{
+    std::vector<uint32_t> posting;
+    for (uint32_t i = 0; i < 1000; ++i)
+        posting.push_back(i * 5 + (i & 3));
+
+    cyber::CompressedIntSequence sorted(true);
+    sorted.assign(posting.data(), posting.size());
+    assert(sorted.size() == 1000 && sorted.block_count() == 8);
+    assert(sorted[0] == posting[0] && sorted[500] == posting[500] && sorted[999] == posting[999]);
+    assert(sorted.lower_bound(posting[300]) == 300 && sorted.lower_bound(posting[999] + 1) == 1000);
+
+    std::vector<uint32_t> decoded(posting.size());
+    sorted.decode(decoded.data());
+    assert(decoded == posting);
+
+    cyber::CompressedIntSequence unsorted(false);
+    for (uint32_t i = 0; i < 300; ++i)
+        unsorted.push_back(1000000 + (i * 7919u) % 1000u);
+    assert(unsorted[129] == 1000000 + (129 * 7919u) % 1000u && unsorted[299] == 1000000 + (299 * 7919u) % 1000u);
+}